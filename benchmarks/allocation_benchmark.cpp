@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+// Counts the heap allocations of getBrush() and getPen(), next to building the brushes and pens on every call as before they were interned,
+// and of painting a few common primitives with the style. operator new is replaced for the whole process, so what Qt allocates is counted too.
+// Every case runs once to fill the caches before it is counted, after that getBrush() and getPen() should not allocate at all.
+
+#include <QApplication>
+#include <QImage>
+#include <QPainter>
+#include <QStyleOption>
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#include "colors.h"
+#include "style.h"
+
+namespace {
+std::atomic<qint64> allocations{0};
+}  // namespace
+
+void* operator new(std::size_t size) {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+namespace {
+using Lilac::Color;
+using Lilac::State;
+
+constexpr int rounds = 1000;
+
+// allocations per call, run makes calls calls
+template <typename Run>
+double allocationsPerCall(const Run& run, const int calls) {
+    run();  // fills the caches
+    const qint64 before = allocations.load(std::memory_order_relaxed);
+    for (int i = 0; i < rounds; i++) {
+        run();
+    }
+    return double(allocations.load(std::memory_order_relaxed) - before) / (double(rounds) * calls);
+}
+
+// the option is set up beforehand, constructing it allocates too
+void printPaint(const char* name, const QStyle& style, const QStyle::PrimitiveElement element, QStyleOption* option, const QRect& rect, const QStyle::State state) {
+    option->palette = QApplication::palette();
+    option->rect = rect;
+    option->state = state;
+
+    QImage image(200, 80, QImage::Format_ARGB32_Premultiplied);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    std::printf("  %-26s %8.3f\n", name, allocationsPerCall([&]() { style.drawPrimitive(element, option, &painter, nullptr); }, 1));
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    const QPalette palette = QApplication::palette();
+
+    // every color in the states the elements use
+    QList<std::pair<Color, State>> colors;
+    for (int color = 0; color <= int(Color::tooltipBg); color++) {
+        for (const QStyle::State state : {QStyle::State_Enabled, QStyle::State_Enabled | QStyle::State_MouseOver, QStyle::State_Enabled | QStyle::State_Sunken, QStyle::State_None}) {
+            colors.append({Color(color), State(state)});
+        }
+    }
+    const int calls = colors.size();
+
+    std::printf("allocations per call\n");
+    std::printf("  %-26s %8.3f\n", "getBrush()", allocationsPerCall([&]() {
+                    for (const auto& [color, state] : colors) {
+                        Lilac::getBrush(palette, color, state);
+                    }
+                }, calls));
+    std::printf("  %-26s %8.3f\n", "getPen()", allocationsPerCall([&]() {
+                    for (const auto& [color, state] : colors) {
+                        Lilac::getPen(palette, color, state, 1);
+                    }
+                }, calls));
+    std::printf("  %-26s %8.3f\n", "QBrush(getColor())", allocationsPerCall([&]() {
+                    for (const auto& [color, state] : colors) {
+                        const QBrush brush(Lilac::getColor(palette, color, state));
+                    }
+                }, calls));
+    std::printf("  %-26s %8.3f\n", "QPen(getColor())", allocationsPerCall([&]() {
+                    for (const auto& [color, state] : colors) {
+                        const QPen pen(QBrush(Lilac::getColor(palette, color, state)), 1);
+                    }
+                }, calls));
+
+    // the settings are not read, without an event loop the defaults are used
+    Lilac::Style style;
+    std::printf("allocations per drawPrimitive()\n");
+    QStyleOptionButton button;
+    printPaint("PE_PanelButtonCommand", style, QStyle::PE_PanelButtonCommand, &button, QRect(10, 10, 120, 32), QStyle::State_Enabled | QStyle::State_MouseOver);
+    QStyleOptionFrame frame;
+    frame.lineWidth = 1;
+    printPaint("PE_FrameLineEdit", style, QStyle::PE_FrameLineEdit, &frame, QRect(10, 10, 160, 32), QStyle::State_Enabled | QStyle::State_HasFocus);
+    QStyleOption indicator;
+    printPaint("PE_IndicatorCheckBox", style, QStyle::PE_IndicatorCheckBox, &indicator, QRect(10, 10, 20, 20), QStyle::State_Enabled | QStyle::State_On);
+    QStyleOptionViewItem item;
+    printPaint("PE_PanelItemViewItem", style, QStyle::PE_PanelItemViewItem, &item, QRect(0, 0, 200, 28), QStyle::State_Enabled | QStyle::State_Selected);
+    return 0;
+}
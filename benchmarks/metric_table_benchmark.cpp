@@ -0,0 +1,241 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+// Compares looking up the option and widget independent pixel metrics and style hints in the tables of src/static_metrics.h
+// with the switch statements they replaced, both on top of QCommonStyle, and prints the time per call.
+// The keys are asked for through a QStyle pointer, the same virtual call an application makes.
+
+#include <QApplication>
+#include <QCommonStyle>
+#include <QElapsedTimer>
+#include <QFrame>
+
+#include <cstdio>
+#include <vector>
+
+#include "static_metrics.h"
+
+namespace {
+using Lilac::Config;
+
+constexpr int iterations = 200000;
+
+// the switch statements of Style::pixelMetric() and Style::styleHint() before the tables,
+// without the cases which depend on the configuration, those are in both answered from the same variables
+class SwitchStyle : public QCommonStyle {
+   public:
+    int pixelMetric(PixelMetric m, const QStyleOption* opt, const QWidget* widget) const override {
+        switch (m) {
+            case PM_ButtonShiftHorizontal:
+            case PM_ButtonShiftVertical:
+                return 0;
+            case PM_IndicatorHeight:
+            case PM_IndicatorWidth:
+            case PM_ExclusiveIndicatorWidth:
+            case PM_ExclusiveIndicatorHeight:
+                return Config::checkBoxSize;
+            case PM_TabBarTabHSpace:
+                return Config::tabHorizontalPadding;
+            case PM_TabBarTabVSpace:
+                return Config::tabVerticalPadding;
+            case PM_TabBarTabShiftHorizontal:
+            case PM_TabBarTabShiftVertical:
+                return 0;
+            case PM_TabCloseIndicatorWidth:
+            case PM_TabCloseIndicatorHeight:
+                return Config::tabCloseIndicatorHoverSize;
+            case PM_SliderControlThickness:
+            case PM_SliderLength:
+                return Config::sliderHandleDiameter;
+            case PM_SliderTickmarkOffset:
+                return Config::sliderTickmarksOffset;
+            case PM_ScrollBarSliderMin:
+                return Config::scrollbarSliderMinLen;
+            case PM_MenuHMargin:
+                return Config::menuMargin;
+            case PM_MenuVMargin:
+                return Config::menuVerticalPadding + Config::menuMargin;
+            case PM_SubMenuOverlap:
+                return Config::menuMargin * 2 - Config::menuSubMenuSpacing;
+            case PM_MenuBarItemSpacing:
+                return 0;
+            case PM_MenuBarHMargin:
+            case PM_MenuBarVMargin:
+                return Config::menuBarMargin;
+            case PM_MenuBarPanelWidth:
+                return 0;
+            case PM_ToolBarFrameWidth:
+                return 0;
+            case PM_ToolBarItemMargin:
+                return Config::toolBarPadding;
+            case PM_ToolBarItemSpacing:
+                return Config::toolBarItemSpacing;
+            case PM_ToolBarSeparatorExtent:
+                return 3;
+            case PM_ToolBarHandleExtent:
+                return Config::toolBarHandleHorizontalPadding * 2 + 2 + Config::toolBarHandleLineSpacing;
+            case PM_ProgressBarChunkWidth:
+                return 2;
+            case PM_RadioButtonLabelSpacing:
+            case PM_CheckBoxLabelSpacing:
+                return Config::checkBoxElementSpacing + Config::checkBoxSize / 2;
+            case PM_DockWidgetTitleMargin:
+                return Config::dockHeaderLabelPadding;
+            case PM_DockWidgetFrameWidth:
+                return 0;
+            case PM_DockWidgetTitleBarButtonMargin:
+                return Config::dockHeaderControlsHoverPadding;
+            case PM_DockWidgetSeparatorExtent:
+            case PM_DockWidgetHandleExtent:
+                return 3;
+            case PM_ToolTipLabelFrameWidth:
+                return Config::tooltipPadding;
+            default:
+                break;
+        }
+        return QCommonStyle::pixelMetric(m, opt, widget);
+    }
+
+    int styleHint(StyleHint hint, const QStyleOption* option, const QWidget* widget, QStyleHintReturn* returnData) const override {
+        switch (hint) {
+            case SH_UnderlineShortcut:
+                return false;
+            case SH_MenuBar_MouseTracking:
+                return true;
+            case SH_Menu_Scrollable:
+                return true;
+            case SH_Menu_MouseTracking:
+                return true;
+            case SH_Menu_SubMenuPopupDelay:
+                return 150;
+            case SH_Menu_SloppySubMenus:
+                return true;
+            case SH_Menu_SupportsSections:
+                return true;
+            case SH_DrawMenuBarSeparator:
+                return false;
+            case SH_TabBar_Alignment:
+                return Qt::AlignLeft;
+            case SH_TabBar_PreferNoArrows:
+                return false;
+            case SH_ComboBox_Popup:
+                return false;
+            case SH_ComboBox_PopupFrameStyle:
+                return QFrame::StyledPanel;
+            case SH_ItemView_ShowDecorationSelected:
+                return true;
+            case SH_FocusFrame_AboveWidget:
+                return true;
+            case SH_FocusFrame_Mask:
+                return false;
+            case SH_Slider_AbsoluteSetButtons:
+                return true;
+#if !HAS_KSTYLE
+            case SH_Menu_SubMenuSloppyCloseTimeout:
+                return 300;
+            case SH_ScrollBar_LeftClickAbsolutePosition:
+                return true;
+            case SH_ToolButtonStyle:
+                return Qt::ToolButtonTextBesideIcon;
+#endif
+            default:
+                break;
+        }
+        return QCommonStyle::styleHint(hint, option, widget, returnData);
+    }
+};
+
+// the same lookup as Style::pixelMetric() and Style::styleHint()
+class TableStyle : public QCommonStyle {
+   public:
+    int pixelMetric(PixelMetric m, const QStyleOption* opt, const QWidget* widget) const override {
+        int value;
+        if (pixelMetrics.find(m, &value)) {
+            return value;
+        }
+        return QCommonStyle::pixelMetric(m, opt, widget);
+    }
+
+    int styleHint(StyleHint hint, const QStyleOption* option, const QWidget* widget, QStyleHintReturn* returnData) const override {
+        int value;
+        if (styleHints.find(hint, &value)) {
+            return value;
+        }
+        return QCommonStyle::styleHint(hint, option, widget, returnData);
+    }
+
+   private:
+    Lilac::MetricTable<QStyle::PixelMetric> pixelMetrics = Lilac::staticPixelMetrics;
+    Lilac::MetricTable<QStyle::StyleHint> styleHints = Lilac::staticStyleHints;
+};
+
+template <typename Enum>
+struct Keys {
+    std::vector<Enum> inTable;
+    std::vector<Enum> other;
+};
+
+template <typename Enum>
+Keys<Enum> splitKeys(const Lilac::MetricTable<Enum>& table, const Enum last) {
+    Keys<Enum> keys;
+    for (int key = 0; key <= int(last); key++) {
+        int value;
+        (table.find(Enum(key), &value) ? keys.inTable : keys.other).push_back(Enum(key));
+    }
+    return keys;
+}
+
+// the style is read through a volatile pointer, so that the compiler cannot see its type and skip the virtual call
+template <typename Enum, typename Ask>
+double nsPerCall(const std::vector<Enum>& keys, const QStyle* const volatile style, const Ask& ask) {
+    volatile int sink = 0;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < iterations; i++) {
+        for (const Enum key : keys) {
+            sink = sink + ask(style, key);
+        }
+    }
+    return double(timer.nsecsElapsed()) / (double(iterations) * keys.size());
+}
+
+template <typename Enum, typename Ask>
+void compare(const char* name, const std::vector<Enum>& keys, const Ask& ask, const QStyle* before, const QStyle* after) {
+    int mismatches = 0;
+    for (const Enum key : keys) {
+        mismatches += ask(before, key) != ask(after, key);
+    }
+    const double beforeTime = nsPerCall(keys, before, ask);
+    const double afterTime = nsPerCall(keys, after, ask);
+    std::printf("  %-22s %3zu keys   switch %6.2f ns   table %6.2f ns   speedup %5.2fx   different answers %d\n",
+                name,
+                keys.size(),
+                beforeTime,
+                afterTime,
+                beforeTime / afterTime,
+                mismatches);
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+
+    const SwitchStyle before;
+    const TableStyle after;
+
+    const auto pixelMetricKeys = splitKeys(Lilac::staticPixelMetrics, QStyle::PM_LineEditIconMargin);
+    const auto styleHintKeys = splitKeys(Lilac::staticStyleHints, QStyle::SH_Table_AlwaysDrawLeftTopGridLines);
+    const auto pixelMetric = [](const QStyle* style, QStyle::PixelMetric m) { return style->pixelMetric(m); };
+    const auto styleHint = [](const QStyle* style, QStyle::StyleHint hint) { return style->styleHint(hint); };
+
+    std::printf("pixelMetric()\n");
+    compare("in the table", pixelMetricKeys.inTable, pixelMetric, &before, &after);
+    compare("passed to QCommonStyle", pixelMetricKeys.other, pixelMetric, &before, &after);
+    std::printf("styleHint()\n");
+    compare("in the table", styleHintKeys.inTable, styleHint, &before, &after);
+    compare("passed to QCommonStyle", styleHintKeys.other, styleHint, &before, &after);
+    return 0;
+}
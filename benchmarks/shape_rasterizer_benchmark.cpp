@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+// Compares the analytic rasterizer of src/utils/shape_rasterizer.h with QPainter drawing the same shapes,
+// on images like the backing store of a window, and prints the time per shape and the largest difference of a channel.
+
+#include <QElapsedTimer>
+#include <QImage>
+#include <QPainter>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+#include "utils/shape_rasterizer.h"
+
+namespace {
+struct Case {
+    const char* name;
+    QRectF rect;
+    qreal radius;
+    QColor color;
+};
+
+constexpr int iterations = 2000;
+
+qint64 run(QImage* image, const std::function<void(QPainter*)>& draw, const int count) {
+    image->fill(QColor(240, 240, 240));
+    QPainter painter(image);
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < count; i++) {
+        draw(&painter);
+    }
+    painter.end();
+    return timer.nsecsElapsed();
+}
+
+int maxDifference(const QImage& lhs, const QImage& rhs) {
+    int difference = 0;
+    for (int y = 0; y < lhs.height(); y++) {
+        const auto* lhsLine = reinterpret_cast<const quint32*>(lhs.constScanLine(y));
+        const auto* rhsLine = reinterpret_cast<const quint32*>(rhs.constScanLine(y));
+        for (int x = 0; x < lhs.width(); x++) {
+            for (int shift = 0; shift < 32; shift += 8) {
+                difference = std::max(difference, std::abs(int((lhsLine[x] >> shift) & 0xff) - int((rhsLine[x] >> shift) & 0xff)));
+            }
+        }
+    }
+    return difference;
+}
+}  // namespace
+
+int main() {
+    const Case cases[] = {
+        {"button", QRectF(10, 10, 120, 32), 6, QColor(61, 174, 233)},
+        {"menu item", QRectF(10, 10, 280, 28), 6, QColor(61, 174, 233, 60)},
+        {"scrollbar slider", QRectF(10, 10, 8, 200), 4, QColor(0, 0, 0, 110)},
+        {"progress bar", QRectF(10, 10.5, 300, 6), 3, QColor(61, 174, 233)},
+        {"hover circle", QRectF(10, 10, 28, 28), 14, QColor(61, 174, 233, 40)},
+    };
+
+    for (const QImage::Format format : {QImage::Format_ARGB32_Premultiplied, QImage::Format_RGB32}) {
+        std::printf("%s\n", format == QImage::Format_RGB32 ? "Format_RGB32 (opaque backing store)" : "Format_ARGB32_Premultiplied (translucent backing store)");
+        for (const Case& shape : cases) {
+            const auto analytic = [&shape](QPainter* p) { Lilac::fillRoundedRect(p, shape.rect, shape.radius, shape.color); };
+            const auto painter = [&shape](QPainter* p) {
+                p->setRenderHint(QPainter::Antialiasing);
+                p->setPen(Qt::NoPen);
+                p->setBrush(shape.color);
+                p->drawRoundedRect(shape.rect, shape.radius, shape.radius);
+            };
+
+            QImage image(320, 240, format);
+            const qint64 analyticTime = run(&image, analytic, iterations);
+            const qint64 painterTime = run(&image, painter, iterations);
+
+            // compared after drawing once, the repeated shapes are blended over each other
+            QImage analyticImage(320, 240, format);
+            QImage painterImage(320, 240, format);
+            run(&analyticImage, analytic, 1);
+            run(&painterImage, painter, 1);
+
+            std::printf("  %-17s analytic %8.1f ns   QPainter %8.1f ns   speedup %5.2fx   max difference %d\n",
+                        shape.name,
+                        double(analyticTime) / iterations,
+                        double(painterTime) / iterations,
+                        double(painterTime) / double(std::max<qint64>(analyticTime, 1)),
+                        maxDifference(analyticImage, painterImage));
+        }
+    }
+    return 0;
+}
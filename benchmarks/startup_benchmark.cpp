@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+// Measures what the style costs an application at startup: loading the plugin and creating the style,
+// the first frame of a typical window, and the first turn of the event loop, in which the settings are read (see Config).
+// The StyleChange events of that turn are counted, unless the settings change the layout there are none.
+// Fusion is measured the same way for comparison. The plugin is the one in the build directory, or the path given as the argument.
+
+#include <QApplication>
+#include <QCheckBox>
+#include <QComboBox>
+#include <QElapsedTimer>
+#include <QFormLayout>
+#include <QGroupBox>
+#include <QLineEdit>
+#include <QMainWindow>
+#include <QMenuBar>
+#include <QPluginLoader>
+#include <QProgressBar>
+#include <QPushButton>
+#include <QRadioButton>
+#include <QSlider>
+#include <QSpinBox>
+#include <QStyleFactory>
+#include <QStylePlugin>
+#include <QTabWidget>
+#include <QTableWidget>
+#include <QToolBar>
+#include <QVBoxLayout>
+
+#include <cstdio>
+#include <functional>
+#include <memory>
+
+namespace {
+class StyleChangeCounter : public QObject {
+   public:
+    int count = 0;
+
+   protected:
+    bool eventFilter(QObject* object, QEvent* event) override {
+        if (event->type() == QEvent::StyleChange) {
+            count++;
+        }
+        return QObject::eventFilter(object, event);
+    }
+};
+
+std::unique_ptr<QMainWindow> createWindow() {
+    auto window = std::make_unique<QMainWindow>();
+    for (const char* title : {"&File", "&Edit", "&View", "&Help"}) {
+        QMenu* menu = window->menuBar()->addMenu(QString::fromLatin1(title));
+        for (int i = 0; i < 8; i++) {
+            menu->addAction(QStringLiteral("Action %1").arg(i));
+        }
+    }
+    QToolBar* toolBar = window->addToolBar(QStringLiteral("Main"));
+    for (int i = 0; i < 6; i++) {
+        toolBar->addAction(QStringLiteral("Tool %1").arg(i));
+    }
+
+    auto* tabs = new QTabWidget;
+    auto* form = new QWidget;
+    auto* formLayout = new QFormLayout(form);
+    formLayout->addRow(QStringLiteral("Name"), new QLineEdit);
+    auto* combo = new QComboBox;
+    combo->addItems({QStringLiteral("One"), QStringLiteral("Two"), QStringLiteral("Three")});
+    formLayout->addRow(QStringLiteral("Choice"), combo);
+    formLayout->addRow(QStringLiteral("Count"), new QSpinBox);
+    formLayout->addRow(QStringLiteral("Level"), new QSlider(Qt::Horizontal));
+    auto* progress = new QProgressBar;
+    progress->setValue(40);
+    formLayout->addRow(QStringLiteral("Progress"), progress);
+    auto* group = new QGroupBox(QStringLiteral("Options"));
+    auto* groupLayout = new QVBoxLayout(group);
+    groupLayout->addWidget(new QCheckBox(QStringLiteral("Check")));
+    groupLayout->addWidget(new QRadioButton(QStringLiteral("Radio")));
+    formLayout->addRow(group);
+    formLayout->addRow(new QPushButton(QStringLiteral("Apply")));
+    tabs->addTab(form, QStringLiteral("Form"));
+
+    auto* table = new QTableWidget(200, 5);
+    for (int row = 0; row < table->rowCount(); row++) {
+        for (int column = 0; column < table->columnCount(); column++) {
+            table->setItem(row, column, new QTableWidgetItem(QStringLiteral("%1, %2").arg(row).arg(column)));
+        }
+    }
+    tabs->addTab(table, QStringLiteral("Table"));
+
+    window->setCentralWidget(tabs);
+    window->resize(800, 600);
+    window->setAttribute(Qt::WA_DontShowOnScreen);
+    return window;
+}
+
+double ms(const qint64 ns) {
+    return double(ns) / 1e6;
+}
+
+// the style is created and owned by the application from the call of createStyle on
+bool measure(const char* name, const std::function<QStyle*()>& createStyle, StyleChangeCounter* counter) {
+    QElapsedTimer timer;
+    timer.start();
+    QStyle* style = createStyle();
+    const qint64 createTime = timer.nsecsElapsed();
+    if (!style) {
+        std::printf("%s: the style could not be created\n", name);
+        return false;
+    }
+    QApplication::setStyle(style);
+
+    // polished, laid out and painted
+    timer.restart();
+    const std::unique_ptr<QMainWindow> window = createWindow();
+    window->show();
+    window->grab();
+    const qint64 firstFrameTime = timer.nsecsElapsed();
+
+    // one turn reads the settings and posts the StyleChange events, the next one delivers them, the frame after shows the result
+    counter->count = 0;
+    timer.restart();
+    QCoreApplication::processEvents();
+    QCoreApplication::processEvents();
+    window->grab();
+    const qint64 settingsTime = timer.nsecsElapsed();
+
+    std::printf("%-6s  create style %8.2f ms   first frame %8.2f ms   first event loop turn and frame %8.2f ms   StyleChange events %d\n",
+                name,
+                ms(createTime),
+                ms(firstFrameTime),
+                ms(settingsTime),
+                counter->count);
+    return true;
+}
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) {
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+    }
+    QApplication app(argc, argv);
+    const QString pluginPath = argc > 1 ? QString::fromLocal8Bit(argv[1]) : QStringLiteral(LILAC_PLUGIN_PATH);
+
+    StyleChangeCounter counter;
+    app.installEventFilter(&counter);
+
+    // loads the fonts, the platform plugin and the rest of Qt which both styles share, so neither pays for it
+    QApplication::setStyle(QStyleFactory::create(QStringLiteral("Fusion")));
+    {
+        const std::unique_ptr<QMainWindow> window = createWindow();
+        window->show();
+        window->grab();
+        QCoreApplication::processEvents();
+    }
+
+    measure("Fusion", []() { return QStyleFactory::create(QStringLiteral("Fusion")); }, &counter);
+
+    // the plugin can only be loaded once per process, so this is measured once
+    QPluginLoader loader(pluginPath);
+    const bool loaded = measure(
+        "Lilac",
+        [&loader]() -> QStyle* {
+            auto* plugin = qobject_cast<QStylePlugin*>(loader.instance());
+            return plugin ? plugin->create(QStringLiteral("Lilac")) : nullptr;
+        },
+        &counter);
+    if (!loaded) {
+        std::printf("%s\n", qPrintable(loader.errorString()));
+        return 1;
+    }
+    return 0;
+}
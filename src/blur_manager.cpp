@@ -7,8 +7,9 @@
 
 namespace Lilac {
 
-BlurManager::BlurManager(QObject* parent)
-    : QObject(parent) {
+BlurManager::BlurManager(EventDispatcher* dispatcher, QObject* parent)
+    : QObject(parent), dispatcher(dispatcher) {
+    dispatcher->setHandler(EventDispatcher::Blur, this);
     connect(&Config::get(), &Config::configChanged, this, &BlurManager::reapplyBlur);
 }
 
@@ -16,13 +17,13 @@ bool BlurManager::shouldBlurBehindWidget(QWidget* widget) {
     return widget->inherits("QMenu");
 }
 void BlurManager::registerWidget(QWidget* widget) {
-    widget->installEventFilter(this);
+    dispatcher->registerObject(widget, EventDispatcher::Blur);
     regsteredWidgets.insert(widget);
     connect(widget, &QWidget::destroyed, this, [widget, this]() { this->regsteredWidgets.remove(widget); });
 }
 
 void BlurManager::unregisterWidget(QWidget* widget) {
-    widget->removeEventFilter(this);
+    dispatcher->unregisterObject(widget, EventDispatcher::Blur);
     regsteredWidgets.remove(widget);
 }
 
@@ -7,11 +7,13 @@
 #include <QRegion>
 #include <QWidget>
 
+#include "event_dispatcher.h"
+
 namespace Lilac {
 class BlurManager : public QObject {
     Q_OBJECT
    public:
-    explicit BlurManager(QObject* parent = nullptr);
+    explicit BlurManager(EventDispatcher* dispatcher, QObject* parent = nullptr);
 
     static bool shouldBlurBehindWidget(QWidget* Widget);
 
@@ -29,6 +31,7 @@ class BlurManager : public QObject {
     void enableBlur(QWidget* widget);
 
    private:
+    EventDispatcher* dispatcher;
     QSet<QWidget*> regsteredWidgets;
 };
 
@@ -1,6 +1,11 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 // SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
 
+#include <QHashFunctions>
+
+#include <atomic>
+#include <unordered_map>
+
 #include "colors.h"
 #include "config.h"
 
@@ -35,15 +40,84 @@ const QColor getColor(const QPalette& pal, const Color color, const State& state
 #endif
 }
 
-const QBrush getBrush(const QPalette& pal, const Color color, const State& state) {
-    return QBrush(getColor(pal, color, state));
+namespace {
+struct InternKey {
+    qint64 paletteKey;  // QPalette::cacheKey(), changes whenever the palette does
+    Color color;
+    quint8 state;
+    qreal penWidth;  // 0 for brushes
+
+    bool operator==(const InternKey& other) const {
+        return paletteKey == other.paletteKey && color == other.color && state == other.state && penWidth == other.penWidth;
+    }
+};
+
+struct InternKeyHash {
+    size_t operator()(const InternKey& key) const {
+        return qHashMulti(0, key.paletteKey, int(key.color), key.state, key.penWidth);
+    }
+};
+
+std::atomic<quint32> configGeneration{0};
+
+// Two generations, when the current one is full it replaces the retired one, which is destroyed,
+// so a reference handed out lives through at least maxEntries further insertions.
+// std::unordered_map, unlike QHash, keeps the references to its values valid while it grows and when it is moved.
+template <typename T>
+class InternPool {
+   public:
+    template <typename Make>
+    const T& get(const InternKey& key, const Make& make) {
+        const quint32 currentGeneration = configGeneration.load(std::memory_order_relaxed);
+        if (generation != currentGeneration) {
+            generation = currentGeneration;
+            current.clear();
+            retired.clear();
+        }
+
+        if (const auto it = current.find(key); it != current.end()) {
+            return it->second;
+        }
+        if (current.size() >= maxEntries) {
+            retired = std::move(current);
+            current.clear();
+        }
+        if (const auto it = retired.find(key); it != retired.end()) {
+            return current.try_emplace(key, it->second).first->second;  // a shallow copy
+        }
+        return current.try_emplace(key, make()).first->second;
+    }
+
+   private:
+    static constexpr size_t maxEntries = 1024;
+
+    quint32 generation = 0;
+    std::unordered_map<InternKey, T, InternKeyHash> current;
+    std::unordered_map<InternKey, T, InternKeyHash> retired;
+};
+
+quint8 stateBits(const State& state) {
+    return quint8(state.enabled) | quint8(state.hovered) << 1 | quint8(state.pressed) << 2 | quint8(state.hasFocus) << 3;
+}
+
+// per thread, so that painting outside of the gui thread does not need locking
+thread_local InternPool<QBrush> brushPool;
+thread_local InternPool<QPen> penPool;
+}  // namespace
+
+const QBrush& getBrush(const QPalette& pal, const Color color, const State& state) {
+    return brushPool.get({pal.cacheKey(), color, stateBits(state), 0}, [&]() { return QBrush(getColor(pal, color, state)); });
 }
 
-const QPen getPen(const QPalette& pal, const Color color, const State& state, const qreal penWidth) {
-    return QPen(QBrush(getColor(pal, color, state)), penWidth);
+const QPen& getPen(const QPalette& pal, const Color color, const State& state, const qreal penWidth) {
+    return penPool.get({pal.cacheKey(), color, stateBits(state), penWidth}, [&]() { return QPen(QBrush(getColor(pal, color, state)), penWidth); });
 }
-const QPen getPen(const QPalette& pal, const Color color, const qreal penWidth) {
-    return QPen(QBrush(getColor(pal, color)), penWidth);
+const QPen& getPen(const QPalette& pal, const Color color, const qreal penWidth) {
+    return getPen(pal, color, State(), penWidth);
+}
+
+void invalidateBrushesAndPens() {
+    configGeneration.fetch_add(1, std::memory_order_relaxed);
 }
 
 static QColor getColorFromPallete(const QPalette& pal, const Color color, const State& state) {
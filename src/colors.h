@@ -130,9 +130,13 @@ enum Color {
 };
 
 const QColor getColor(const QPalette& pal, const Color color, const State& state = State());
-const QBrush getBrush(const QPalette& pal, const Color color, const State& state = State());
-const QPen getPen(const QPalette& pal, const Color color, const State& state, const qreal penWidth = 1);  // this needs to have an overload due to
-const QPen getPen(const QPalette& pal, const Color color, const qreal penWidth = 1);                      // the way optional parameters are handled
+
+// brushes and pens are built once per palette and configuration and shared,
+// the reference stays valid until the configuration changes, and for at least the next 1024 other brushes or pens of the thread
+const QBrush& getBrush(const QPalette& pal, const Color color, const State& state = State());
+const QPen& getPen(const QPalette& pal, const Color color, const State& state, const qreal penWidth = 1);  // this needs to have an overload due to
+const QPen& getPen(const QPalette& pal, const Color color, const qreal penWidth = 1);                      // the way optional parameters are handled
+void invalidateBrushesAndPens();                                                                           // when the configuration changes, colors depend on it
 
 const bool isDarkMode(const QPalette& pal);
 
@@ -1,9 +1,15 @@
+#include <QCoreApplication>
+#include <QTimer>
+
+#include <tuple>
+
 #if HAS_DBUS
 #include <QDBusConnection>
 #endif
 
 #if HAS_SETTINGS
 #include "settings.h"
+#include "settings/settings_payload.h"
 #endif
 
 #include "config.h"
@@ -11,6 +17,25 @@
 namespace Lilac {
 
 Config::Config() {
+#if HAS_SETTINGS
+    // the defaults of settings.kcfg, where they differ from the ones used without settings
+    menuBgOpacity = 255;
+    menuDrawOutline = false;
+#endif
+
+    if (QCoreApplication::instance()) {
+        QTimer::singleShot(0, this, &Config::initialize);
+    } else {
+        initialize();  // there is no event loop to wait for
+    }
+}
+
+const Config& Config::get() {
+    static Config instance;
+    return instance;
+}
+
+void Config::initialize() {
 #if HAS_DBUS
     auto dbus = QDBusConnection::sessionBus();
     dbus.connect(
@@ -19,7 +44,7 @@ Config::Config() {
         "com.github.zalesyc.lilac",
         "settingsChanged",
         this,
-        SLOT(onSettingsChanged()));
+        SLOT(onSettingsChangedSignal(QDBusMessage)));
     dbus.connect(
         "",
         "/KGlobalSettings",
@@ -40,16 +65,39 @@ Config::Config() {
 #endif
 }
 
-const Config& Config::get() {
-    return instance;
+#if HAS_SETTINGS
+void Config::onSettingsChanged() {
+    LilacSettings::self()->load();
+    readSettings();
 }
 
-Config Config::instance;
+void Config::onSettingsPayload(const QByteArray& payload) {
+    const auto settings = LilacSettings::self();
+    if (!applySettingsPayload(settings, payload)) {
+        settings->load();  // sent by a different version of the settings app
+    }
+    readSettings();
+}
 
-#if HAS_SETTINGS
-void Config::onSettingsChanged() {
+#if HAS_DBUS
+void Config::onSettingsChangedSignal(const QDBusMessage& message) {
+    // settings apps from before the payload send the signal without arguments,
+    // one connection for each signature would call both slots for the signal with the payload, as QtDBus drops the extra arguments
+    const QList<QVariant> arguments = message.arguments();
+    if (!arguments.isEmpty() && arguments.first().metaType() == QMetaType::fromType<QByteArray>()) {
+        onSettingsPayload(arguments.first().toByteArray());
+    } else {
+        onSettingsChanged();
+    }
+}
+#endif
+
+void Config::readSettings() {
     const auto settings = LilacSettings::self();
-    settings->load();
+
+    // what sizeFromContents(), subElementRect() and subControlRect() read
+    const auto layoutValues = [this]() { return std::make_tuple(groupBoxAltStyle, tabContentAlignment, spinVerticalControlsForNullWidgets); };
+    const auto previousLayoutValues = layoutValues();
 
     int settingsCornerRadius = settings->cornerRadius();
     cornerRadius = settingsCornerRadius;
@@ -68,7 +116,13 @@ void Config::onSettingsChanged() {
     menuDrawOutline = settings->menuDrawOutline();
     groupBoxAltStyle = settings->groupBoxAltStyle();
     windowDragMode = static_cast<WindowDragMode>(settings->windowDragMode());
+    windowDragWhiteList = settings->windowDragWhiteList();
+    windowDragBlackList = settings->windowDragBlackList();
+    scrollBarOverlay = settings->scrollBarOverlay();
+    prewarmCaches = settings->prewarmCaches();
+    diskCache = settings->diskCache();
 
+    lastChangeAffectsLayout = layoutValues() != previousLayoutValues;
     emit configChanged();
 }
 #endif
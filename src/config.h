@@ -5,10 +5,19 @@
 
 #include <QObject>
 #include <QPoint>
+#include <QStringList>
+
+#if HAS_DBUS
+#include <QDBusMessage>
+#endif
 
 namespace Lilac {
 
-// this class is a singleton
+// this class is a singleton, created on the first call to get()
+//
+// Until the event loop runs, the built in defaults are used, the settings file is read and the D-Bus signals
+// are connected only afterwards, so that loading the plugin and creating the style does not block the startup.
+// configChanged is emitted once the settings are read.
 class Config : public QObject {
     Q_OBJECT
 
@@ -26,6 +35,12 @@ class Config : public QObject {
 
     static const Config& get();
 
+    // whether the last configChanged changed a value, other than scrollBarOverlay, which sizes or lays out widgets,
+    // before the first one the values are the built in defaults, which the first widgets are laid out with
+    bool layoutChanged() const {
+        return lastChangeAffectsLayout;
+    }
+
    signals:
     void configChanged();
 
@@ -33,11 +48,21 @@ class Config : public QObject {
     Config();
 
    private:
-    static Config instance;
+    bool lastChangeAffectsLayout = false;
+
+   private:
+#if HAS_SETTINGS
+    void readSettings();  // from LilacSettings, which has to be up to date
+#endif
 
    private slots:
+    void initialize();  // connects to D-Bus and reads the settings
 #if HAS_SETTINGS
-    void onSettingsChanged();
+    void onSettingsChanged();                            // reads lilacrc
+    void onSettingsPayload(const QByteArray& payload);  // from the settings app, see settings/settings_payload.h
+#endif
+#if HAS_DBUS
+    void onSettingsChangedSignal(const QDBusMessage& message);  // com.github.zalesyc.lilac settingsChanged, with or without the payload
 #endif
     /*
      * padding and margin are used acording to the css box model:
@@ -57,6 +82,10 @@ class Config : public QObject {
    public:
     int cornerRadius = 12;  // for the elements that dont have their own corner radius
     WindowDragMode windowDragMode = ToolbarOnly;
+    QStringList windowDragWhiteList;  // entries in the form of ClassName or ClassName@appname, in addition to the built in ones
+    QStringList windowDragBlackList;
+    bool prewarmCaches = true;  // render common elements on a worker thread at startup
+    bool diskCache = false;     // share the shadows rendered at startup with other processes, through $XDG_CACHE_HOME/lilac
 
     static constexpr int smallArrowSize = 10;
     static constexpr int dolphinUrlNavigatorArrowSize = 12;  // the maximal size of the arrows in the dolphin url navigator bar, at the top, workaround - beacuse without this limit, they were too big
@@ -93,6 +122,10 @@ class Config : public QObject {
     static constexpr int scrollBarSliderPadding = 6;  // left and right of the slider -> sets the thickness
     static constexpr int scrollBarSliderPaddingHover = 4;
     static constexpr int scrollbarSliderMinLen = 40;
+    bool scrollBarOverlay = false;                            // thin scrollbars drawn over the content, shown only while scrolling or hovered
+    static constexpr int scrollBarOverlayThickness = 10;      // the viewport does not shrink by this, it lies above the content
+    static constexpr int scrollBarOverlaySliderPadding = 3;   // same as scrollBarSliderPadding, for the overlay mode
+    static constexpr int scrollBarOverlaySliderPaddingHover = 2;
 
     static constexpr int lineEditTextHorizontalPadding = 6;
 
@@ -132,7 +165,8 @@ class Config : public QObject {
     static constexpr int comboTextLeftPadding = lineEditTextHorizontalPadding;  // used left of icon and left of text
     static constexpr int comboPopupPadding = 3;
     static constexpr int comboPopupMargin = 3;
-    static constexpr int comboPopupShadowSize = 5;
+    static constexpr int comboPopupShadowSize = 5;  // how far the shadow reaches, only the part within comboPopupMargin is visible
+    static constexpr QPointF comboPopupShadowOffset = QPointF(0.3, 0.5);
 
     static constexpr int toolBtnMenuArrowSize = 8;              // the small arrow in the bottom left corner
     static constexpr QPoint toolBtnArrowOffset = QPoint(5, 5);  // offset from bottomRight of the widget, for the small arrow in the bottom left
@@ -181,6 +215,9 @@ class Config : public QObject {
     int listViewItemBorderRadius = 6;                          // also for combo box popup itms
     static constexpr int kFilePlacesViewHorizontalMargin = 2;  // special case for QListView, if it's KFilePlacesView like in the left dolphin sidebar, where I dont draw vertical margin, because the list items are too small
 
+    static constexpr int iconDisabledOpacity = 128;       // out of 256, disabled icons are also grayscale
+    static constexpr int iconSelectedTintStrength = 77;  // out of 256, how much of the highlight color is mixed into selected icons
+
     static constexpr int tooltipOpacity = 235;
     static constexpr int tooltipPadding = 6;
 
@@ -193,6 +230,8 @@ class Config : public QObject {
     double animationSpeed = 1;  // if <=0 then the animations are instant, if settings are enabled this value may be overriden
     static constexpr int progressBarBusyDuration = 1000;
     static constexpr int scrollBarShowDuration = 40;
+    static constexpr int scrollBarOverlayHoldDuration = 800;  // how long an overlay scrollbar stays visible after scrolling, before fading out
+    static constexpr int scrollBarOverlayFadeDuration = 150;
 };
 
 }  // namespace Lilac
@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#include "event_dispatcher.h"
+
+namespace Lilac {
+
+EventDispatcher::EventDispatcher(QObject* parent)
+    : QObject(parent) {
+}
+
+void EventDispatcher::setHandler(Role role, QObject* handler) {
+    const int index = roleIndex(role);
+    if (index < 0) {
+        return;
+    }
+    handlers[index] = handler;
+}
+
+void EventDispatcher::registerObject(QObject* object, Role role) {
+    if (!object || role == NoRole) {
+        return;
+    }
+
+    auto it = objectRoles.find(object);
+    if (it != objectRoles.end()) {
+        *it |= role;
+        return;
+    }
+
+    objectRoles.insert(object, role);
+    object->installEventFilter(this);
+    connect(object, &QObject::destroyed, this, [this, object]() { objectRoles.remove(object); });
+}
+
+void EventDispatcher::unregisterObject(QObject* object, Role role) {
+    if (!object) {
+        return;
+    }
+
+    auto it = objectRoles.find(object);
+    if (it == objectRoles.end()) {
+        return;
+    }
+
+    *it &= ~Roles(role);
+    if (*it != NoRole) {
+        return;
+    }
+
+    objectRoles.erase(it);
+    object->removeEventFilter(this);
+    disconnect(object, &QObject::destroyed, this, nullptr);
+}
+
+bool EventDispatcher::eventFilter(QObject* object, QEvent* event) {
+    // most events (and most objects) are of no interest, so reject them before touching the hash
+    const Roles interested = rolesForEvent(event->type());
+    if (interested == NoRole) {
+        return false;
+    }
+
+    const auto it = objectRoles.constFind(object);
+    if (it == objectRoles.constEnd()) {
+        return false;
+    }
+
+    const Roles matched = *it & interested;
+    for (int i = 0; i < roleCount; i++) {
+        if (matched.testFlag(Role(1 << i)) && handlers[i] && handlers[i]->eventFilter(object, event)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+EventDispatcher::Roles EventDispatcher::rolesForEvent(QEvent::Type type) {
+    switch (type) {
+        case QEvent::MouseButtonPress:
+        case QEvent::MouseMove:
+        case QEvent::MouseButtonRelease:
+        case QEvent::ParentChange:
+            return WindowDrag;
+
+        case QEvent::Show:
+        case QEvent::Hide:
+        case QEvent::Resize:
+            return Blur | OpaqueRegion;
+
+        case QEvent::Paint:
+            return ComboPopup;
+
+        default:
+            return NoRole;
+    }
+}
+
+int EventDispatcher::roleIndex(Role role) {
+    for (int i = 0; i < roleCount; i++) {
+        if (role == Role(1 << i)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+}  // namespace Lilac
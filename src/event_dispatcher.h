@@ -0,0 +1,52 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#pragma once
+
+#include <QEvent>
+#include <QHash>
+#include <QObject>
+
+namespace Lilac {
+
+// One event filter shared by the style and all of its managers.
+// Every watched object gets at most this one filter installed, the object's roles decide
+// which handlers get the event, and event types no handler cares about are rejected before any lookup.
+class EventDispatcher : public QObject {
+    Q_OBJECT
+
+   public:
+    enum Role {
+        NoRole = 0,
+        WindowDrag = 1 << 0,
+        Blur = 1 << 1,
+        ComboPopup = 1 << 2,
+        OpaqueRegion = 1 << 3,
+    };
+    Q_DECLARE_FLAGS(Roles, Role)
+
+    explicit EventDispatcher(QObject* parent = nullptr);
+
+    // the eventFilter() of handler is called for objects registered with role, handler may be nullptr
+    void setHandler(Role role, QObject* handler);
+
+    void registerObject(QObject* object, Role role);
+    void unregisterObject(QObject* object, Role role);
+
+   protected:
+    bool eventFilter(QObject* object, QEvent* event) override;
+
+   private:
+    static Roles rolesForEvent(QEvent::Type type);
+    static int roleIndex(Role role);
+
+   private:
+    static constexpr int roleCount = 4;
+
+    QHash<const QObject*, Roles> objectRoles;
+    QObject* handlers[roleCount] = {};
+};
+
+Q_DECLARE_OPERATORS_FOR_FLAGS(EventDispatcher::Roles)
+
+}  // namespace Lilac
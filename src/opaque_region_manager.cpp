@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#if HAS_X11
+
+#include <QDockWidget>
+#include <QGuiApplication>
+#include <QWindow>
+#include <QtMath>
+
+#include <xcb/xcb.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "colors.h"
+#include "config.h"
+#include "opaque_region_manager.h"
+#include "translucency_manager.h"
+
+namespace Lilac {
+
+namespace {
+// the corners are left out as whole squares, which keeps the region at two rectangles
+QRegion roundedRectInterior(const QRect& rect, const int radius) {
+    QRegion region;
+    region += rect.adjusted(radius, 0, -radius, 0);
+    region += rect.adjusted(0, radius, 0, -radius);
+    return region;
+}
+
+QRegion opaqueInterior(const QWidget* widget, const Color background, const int inset, const int radius) {
+    if (getColor(widget->palette(), background).alpha() != 255) {
+        return QRegion();
+    }
+    return roundedRectInterior(widget->rect().adjusted(inset, inset, -inset, -inset), radius);
+}
+}  // namespace
+
+OpaqueRegionManager::OpaqueRegionManager(EventDispatcher* dispatcher, QObject* parent)
+    : QObject(parent), dispatcher(dispatcher) {
+    dispatcher->setHandler(EventDispatcher::OpaqueRegion, this);
+    connect(&Config::get(), &Config::configChanged, this, &OpaqueRegionManager::republish);
+}
+
+bool OpaqueRegionManager::shouldPublishForWidget(const QWidget* widget) {
+    return widget->inherits("QMenu") ||
+           widget->inherits("QTipLabel") ||
+           widget->inherits("QDockWidget") ||
+           widget->inherits("QComboBoxPrivateContainer");
+}
+
+void OpaqueRegionManager::registerWidget(QWidget* widget) {
+    dispatcher->registerObject(widget, EventDispatcher::OpaqueRegion);
+    registeredWidgets.insert(widget);
+    connect(widget, &QWidget::destroyed, this, [widget, this]() { this->registeredWidgets.remove(widget); });
+}
+
+void OpaqueRegionManager::unregisterWidget(QWidget* widget) {
+    dispatcher->unregisterObject(widget, EventDispatcher::OpaqueRegion);
+    registeredWidgets.remove(widget);
+}
+
+QRegion OpaqueRegionManager::opaqueRegion(const QWidget* widget) {
+    if (!TranslucencyManager::hasAlphaChannel(widget)) {
+        return QRegion();  // the compositor does not blend an opaque window anyway
+    }
+
+    const Config& config = Config::get();
+    // the outlines are left out, they may be translucent
+    if (widget->inherits("QMenu")) {
+        return opaqueInterior(widget, Color::menuBg, Config::menuMargin + (config.menuDrawOutline ? 1 : 0), config.menuBorderRadius);
+    }
+    if (widget->inherits("QComboBoxPrivateContainer")) {
+        return opaqueInterior(widget, Color::comboBoxPopupBg, Config::comboPopupMargin + 1, config.menuBorderRadius);
+    }
+    if (widget->inherits("QTipLabel")) {
+        return opaqueInterior(widget, Color::tooltipBg, 0, config.cornerRadius);
+    }
+    const auto* dockWidget = qobject_cast<const QDockWidget*>(widget);
+    // with a custom title bar QDockWidget does not draw PE_FrameDockWidget, the background stays transparent
+    if (dockWidget && dockWidget->isFloating() && !dockWidget->titleBarWidget()) {
+        return opaqueInterior(widget, Color::dockWidgetFloatingBg, 1, (config.cornerRadius + 1) / 2);
+    }
+    return QRegion();
+}
+
+bool OpaqueRegionManager::eventFilter(QObject* object, QEvent* event) {
+    QWidget* widget = qobject_cast<QWidget*>(object);
+    if (!widget) {
+        return QObject::eventFilter(object, event);
+    }
+    const QEvent::Type eventType = event->type();
+    if (eventType != QEvent::Show && eventType != QEvent::Resize) {
+        return QObject::eventFilter(object, event);
+    }
+    publish(widget);
+    return false;
+}
+
+void OpaqueRegionManager::republish() {
+    for (const auto& widget : registeredWidgets) {
+        publish(widget);
+    }
+}
+
+void OpaqueRegionManager::publish(QWidget* widget) {
+    if (!widget->isWindow() || !widget->testAttribute(Qt::WA_WState_Created) || !widget->windowHandle()) {
+        return;  // a docked dock widget, or the window does not exist yet, it is published once it is shown
+    }
+    const auto* x11 = qGuiApp->nativeInterface<QNativeInterface::QX11Application>();
+    if (!x11) {
+        return;
+    }
+    xcb_connection_t* connection = x11->connection();
+
+    if (!opaqueRegionAtom) {
+        static constexpr char name[] = "_NET_WM_OPAQUE_REGION";
+        xcb_intern_atom_reply_t* reply = xcb_intern_atom_reply(connection, xcb_intern_atom(connection, false, std::strlen(name), name), nullptr);
+        if (!reply) {
+            return;
+        }
+        opaqueRegionAtom = reply->atom;
+        std::free(reply);
+    }
+
+    const QWindow* window = widget->windowHandle();
+    const qreal dpr = window->devicePixelRatio();
+    std::vector<quint32> rects;  // x, y, width, height in device pixels
+    for (const QRect& rect : opaqueRegion(widget)) {
+        // rounded inwards, a pixel that is wrongly marked as opaque would show whatever was underneath it before
+        const int left = qCeil(rect.x() * dpr);
+        const int top = qCeil(rect.y() * dpr);
+        const int right = qFloor((rect.x() + rect.width()) * dpr);
+        const int bottom = qFloor((rect.y() + rect.height()) * dpr);
+        if (right > left && bottom > top) {
+            rects.insert(rects.end(), {quint32(left), quint32(top), quint32(right - left), quint32(bottom - top)});
+        }
+    }
+
+    if (rects.empty()) {
+        xcb_delete_property(connection, window->winId(), opaqueRegionAtom);
+    } else {
+        xcb_change_property(connection, XCB_PROP_MODE_REPLACE, window->winId(), opaqueRegionAtom, XCB_ATOM_CARDINAL, 32, rects.size(), rects.data());
+    }
+    xcb_flush(connection);
+}
+
+}  // namespace Lilac
+#endif
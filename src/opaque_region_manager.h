@@ -0,0 +1,51 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#pragma once
+
+#if HAS_X11
+
+#include <QEvent>
+#include <QObject>
+#include <QRegion>
+#include <QSet>
+#include <QWidget>
+
+#include "event_dispatcher.h"
+
+namespace Lilac {
+
+// Tells the compositor which parts of the translucent popups are opaque anyway, through _NET_WM_OPAQUE_REGION,
+// so that it does not have to blend them and can skip drawing what is underneath.
+// Does nothing outside of X11, neither Qt nor KWindowSystem can set the opaque region of a Wayland surface.
+class OpaqueRegionManager : public QObject {
+    Q_OBJECT
+   public:
+    explicit OpaqueRegionManager(EventDispatcher* dispatcher, QObject* parent = nullptr);
+
+    static bool shouldPublishForWidget(const QWidget* widget);
+
+    void registerWidget(QWidget* widget);  // this does not check for shouldPublishForWidget
+    void unregisterWidget(QWidget* widget);
+
+    // in logical pixels, the part of the widget that is painted fully opaque, empty if the widget is not translucent
+    static QRegion opaqueRegion(const QWidget* widget);
+
+   protected:
+    bool eventFilter(QObject* object, QEvent* event) override;
+
+   public slots:
+    void republish();
+
+   private:
+    void publish(QWidget* widget);
+
+   private:
+    EventDispatcher* dispatcher;
+    QSet<QWidget*> registeredWidgets;
+    quint32 opaqueRegionAtom = 0;  // interned on the first use
+};
+
+}  // namespace Lilac
+
+#endif
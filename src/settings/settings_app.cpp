@@ -2,6 +2,7 @@
 // SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
 
 #include "settings_app.h"
+#include "settings_payload.h"
 #include "ui_settings_app.h"
 
 #if HAS_DBUS
@@ -33,6 +34,16 @@ SettingsApp::SettingsApp(QWidget* parent)
     connect(ui->groupBoxAltStyleCheck, &QCheckBox::clicked, this, &SettingsApp::widgetChanged);
     connect(ui->menuOpacitySlider, &QSlider::valueChanged, this, [this](int value) { ui->blurBehindMenusCheck->setEnabled(HAS_KWINDOWSYSTEM && value < 255); });
     connect(ui->windowDragModeCombo, &QComboBox::currentIndexChanged, this, &SettingsApp::widgetChanged);
+    connect(ui->scrollBarOverlayCheck, &QCheckBox::clicked, this, &SettingsApp::widgetChanged);
+    connect(ui->prewarmCachesCheck, &QCheckBox::clicked, this, &SettingsApp::widgetChanged);
+    connect(ui->prewarmCachesCheck, &QCheckBox::toggled, ui->diskCacheCheck, &QCheckBox::setEnabled);
+    connect(ui->diskCacheCheck, &QCheckBox::clicked, this, &SettingsApp::widgetChanged);
+    connect(ui->windowDragWhiteListEdit, &QLineEdit::textChanged, this, &SettingsApp::widgetChanged);
+    connect(ui->windowDragBlackListEdit, &QLineEdit::textChanged, this, &SettingsApp::widgetChanged);
+    connect(ui->windowDragModeCombo, &QComboBox::currentIndexChanged, this, [this](int index) {
+        ui->windowDragWhiteListEdit->setEnabled(index != 0);
+        ui->windowDragBlackListEdit->setEnabled(index != 0);
+    });
 
     loadFromSettings();
 }
@@ -55,12 +66,18 @@ void SettingsApp::save() {
     settings->setMenuDrawOutline(ui->menuOutlineCheck->isChecked());
     settings->setGroupBoxAltStyle(ui->groupBoxAltStyleCheck->isChecked());
     settings->setWindowDragMode(ui->windowDragModeCombo->currentIndex());
+    settings->setScrollBarOverlay(ui->scrollBarOverlayCheck->isChecked());
+    settings->setPrewarmCaches(ui->prewarmCachesCheck->isChecked());
+    settings->setDiskCache(ui->diskCacheCheck->isChecked());
+    settings->setWindowDragWhiteList(textToList(ui->windowDragWhiteListEdit->text()));
+    settings->setWindowDragBlackList(textToList(ui->windowDragBlackListEdit->text()));
     settings->save();
 #if HAS_DBUS
     auto msg = QDBusMessage::createSignal(
         "/LilacStyle",
         "com.github.zalesyc.lilac",
         "settingsChanged");
+    msg << settingsPayload(settings);
     QDBusConnection::sessionBus().send(msg);
 #endif
 }
@@ -78,6 +95,23 @@ void SettingsApp::loadFromSettings() {
     ui->menuOutlineCheck->setChecked(settings->menuDrawOutline());
     ui->groupBoxAltStyleCheck->setChecked(settings->groupBoxAltStyle());
     ui->windowDragModeCombo->setCurrentIndex(settings->windowDragMode());
+    ui->scrollBarOverlayCheck->setChecked(settings->scrollBarOverlay());
+    ui->prewarmCachesCheck->setChecked(settings->prewarmCaches());
+    ui->diskCacheCheck->setChecked(settings->diskCache());
+    ui->diskCacheCheck->setEnabled(settings->prewarmCaches());
+    ui->windowDragWhiteListEdit->setText(settings->windowDragWhiteList().join(QStringLiteral(", ")));
+    ui->windowDragBlackListEdit->setText(settings->windowDragBlackList().join(QStringLiteral(", ")));
+}
+
+QStringList SettingsApp::textToList(const QString& text) {
+    QStringList list;
+    for (const QString& entry : text.split(QLatin1Char(','), Qt::SkipEmptyParts)) {
+        const QString trimmed = entry.trimmed();
+        if (!trimmed.isEmpty()) {
+            list.append(trimmed);
+        }
+    }
+    return list;
 }
 
 SettingsApp::~SettingsApp() {
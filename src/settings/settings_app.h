@@ -27,6 +27,7 @@ class SettingsApp : public QWidget {
 
    private:
     void loadFromSettings();
+    static QStringList textToList(const QString& text);  // comma separated list of entries
 
    private slots:
     void widgetChanged();
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#include <QDataStream>
+#include <QHash>
+#include <QIODevice>
+#include <QVariant>
+
+#include "settings_payload.h"
+
+namespace Lilac {
+
+namespace {
+constexpr QDataStream::Version streamVersion = QDataStream::Qt_6_0;  // the sender and the receiver may use different Qt versions
+}
+
+QByteArray settingsPayload(const LilacSettings* settings) {
+    const KConfigSkeletonItem::List items = settings->items();
+
+    QByteArray payload;
+    QDataStream stream(&payload, QIODevice::WriteOnly);
+    stream.setVersion(streamVersion);
+    stream << settingsPayloadVersion << quint32(items.size());
+    for (const KConfigSkeletonItem* item : items) {
+        stream << item->name() << item->property();
+    }
+    return payload;
+}
+
+bool applySettingsPayload(LilacSettings* settings, const QByteArray& payload) {
+    const KConfigSkeletonItem::List items = settings->items();
+
+    QDataStream stream(payload);
+    stream.setVersion(streamVersion);
+    quint32 version = 0;
+    quint32 count = 0;
+    stream >> version >> count;
+    if (stream.status() != QDataStream::Ok || version != settingsPayloadVersion || count != quint32(items.size())) {
+        return false;
+    }
+
+    QHash<QString, QVariant> values;
+    values.reserve(count);
+    for (quint32 i = 0; i < count; i++) {
+        QString name;
+        QVariant value;
+        stream >> name >> value;
+        values.insert(name, value);
+    }
+    if (stream.status() != QDataStream::Ok || !stream.atEnd()) {
+        return false;
+    }
+
+    // everything is checked first, so that a settings object is never left half updated
+    for (const KConfigSkeletonItem* item : items) {
+        const auto value = values.constFind(item->name());
+        if (value == values.constEnd() || value->metaType() != item->property().metaType()) {
+            return false;
+        }
+    }
+    for (KConfigSkeletonItem* item : items) {
+        item->setProperty(values.value(item->name()));
+    }
+    return true;
+}
+
+}  // namespace Lilac
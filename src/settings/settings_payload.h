@@ -0,0 +1,25 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#pragma once
+
+#include "settings.h"
+
+#include <QByteArray>
+
+namespace Lilac {
+
+// The values of all the settings, sent along with the settingsChanged D-Bus signal,
+// so that the running applications do not all read lilacrc at the same time.
+//
+// It is a QDataStream of the payload version, the number of items and then the name and value of every item.
+// Bump settingsPayloadVersion if the layout changes, items are matched by name so adding settings does not need it.
+constexpr quint32 settingsPayloadVersion = 1;
+
+QByteArray settingsPayload(const LilacSettings* settings);
+
+// sets the values without writing them to disk, returns false and leaves settings untouched
+// if the payload is of another version or does not have exactly the items of settings, then the file has to be read
+bool applySettingsPayload(LilacSettings* settings, const QByteArray& payload);
+
+}  // namespace Lilac
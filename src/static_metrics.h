@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#pragma once
+
+#include <QFrame>
+#include <QStyle>
+
+#include "config.h"
+#include "utils/metric_table.h"
+
+// the option and widget independent answers of Style::pixelMetric() and Style::styleHint(),
+// in a header of their own so that benchmarks/metric_table_benchmark.cpp measures the same tables
+
+namespace Lilac {
+
+// pixel metrics which depend neither on the option, the widget nor the configuration
+inline constexpr MetricTable<QStyle::PixelMetric> staticPixelMetrics = []() {
+    MetricTable<QStyle::PixelMetric> table;
+    table.set({QStyle::PM_ButtonShiftHorizontal, QStyle::PM_ButtonShiftVertical}, 0);
+    table.set({QStyle::PM_IndicatorHeight, QStyle::PM_IndicatorWidth, QStyle::PM_ExclusiveIndicatorWidth, QStyle::PM_ExclusiveIndicatorHeight}, Config::checkBoxSize);
+    table.set(QStyle::PM_TabBarTabHSpace, Config::tabHorizontalPadding);  // unused in the impementation
+    table.set(QStyle::PM_TabBarTabVSpace, Config::tabVerticalPadding);    // vertical padding, for horizontal tabbar: top and bottom
+    table.set({QStyle::PM_TabBarTabShiftHorizontal, QStyle::PM_TabBarTabShiftVertical}, 0);
+    table.set({QStyle::PM_TabCloseIndicatorWidth, QStyle::PM_TabCloseIndicatorHeight}, Config::tabCloseIndicatorHoverSize);
+    table.set({QStyle::PM_SliderControlThickness, QStyle::PM_SliderLength}, Config::sliderHandleDiameter);
+    table.set(QStyle::PM_SliderTickmarkOffset, Config::sliderTickmarksOffset);
+    table.set(QStyle::PM_ScrollBarSliderMin, Config::scrollbarSliderMinLen);
+    table.set(QStyle::PM_MenuHMargin, Config::menuMargin);
+    table.set(QStyle::PM_MenuVMargin, Config::menuVerticalPadding + Config::menuMargin);
+    table.set(QStyle::PM_SubMenuOverlap, Config::menuMargin * 2 - Config::menuSubMenuSpacing);
+    table.set(QStyle::PM_MenuBarItemSpacing, 0);
+    table.set({QStyle::PM_MenuBarHMargin, QStyle::PM_MenuBarVMargin}, Config::menuBarMargin);
+    table.set(QStyle::PM_MenuBarPanelWidth, 0);
+    table.set(QStyle::PM_ToolBarFrameWidth, 0);
+    table.set(QStyle::PM_ToolBarItemMargin, Config::toolBarPadding);
+    table.set(QStyle::PM_ToolBarItemSpacing, Config::toolBarItemSpacing);
+    table.set(QStyle::PM_ToolBarSeparatorExtent, 3);
+    table.set(QStyle::PM_ToolBarHandleExtent, Config::toolBarHandleHorizontalPadding * 2 + 2 + Config::toolBarHandleLineSpacing);  // 2 is for the line thickness
+    table.set(QStyle::PM_ProgressBarChunkWidth, 2);
+    /* here i add 1/2 of the check width as a workaround for qqc2-desktop-theme styled apps,
+     * as they apparently count this distance from the center of the checkbox,
+     * the implementation uses Config::checkBoxElementSpacing
+     */
+    table.set({QStyle::PM_RadioButtonLabelSpacing, QStyle::PM_CheckBoxLabelSpacing}, Config::checkBoxElementSpacing + Config::checkBoxSize / 2);
+    table.set(QStyle::PM_DockWidgetTitleMargin, Config::dockHeaderLabelPadding);
+    table.set(QStyle::PM_DockWidgetFrameWidth, 0);
+    table.set(QStyle::PM_DockWidgetTitleBarButtonMargin, Config::dockHeaderControlsHoverPadding);  // size of the dock header buttons
+    table.set({QStyle::PM_DockWidgetSeparatorExtent, QStyle::PM_DockWidgetHandleExtent}, 3);
+    table.set(QStyle::PM_ToolTipLabelFrameWidth, Config::tooltipPadding);
+    return table;
+}();
+
+// style hints which depend neither on the option, the widget nor the configuration
+inline constexpr MetricTable<QStyle::StyleHint> staticStyleHints = []() {
+    MetricTable<QStyle::StyleHint> table;
+    table.set(QStyle::SH_UnderlineShortcut, false);
+    table.set(QStyle::SH_MenuBar_MouseTracking, true);
+    table.set(QStyle::SH_Menu_Scrollable, true);
+    table.set(QStyle::SH_Menu_MouseTracking, true);
+    table.set(QStyle::SH_Menu_SubMenuPopupDelay, 150);
+    table.set(QStyle::SH_Menu_SloppySubMenus, true);
+    table.set(QStyle::SH_Menu_SupportsSections, true);
+    table.set(QStyle::SH_DrawMenuBarSeparator, false);
+    table.set(QStyle::SH_TabBar_Alignment, Qt::AlignLeft);
+    table.set(QStyle::SH_TabBar_PreferNoArrows, false);
+    table.set(QStyle::SH_ComboBox_Popup, false);
+    table.set(QStyle::SH_ComboBox_PopupFrameStyle, QFrame::StyledPanel);
+    table.set(QStyle::SH_ItemView_ShowDecorationSelected, true);
+    table.set(QStyle::SH_FocusFrame_AboveWidget, true);
+    table.set(QStyle::SH_FocusFrame_Mask, false);
+    table.set(QStyle::SH_Slider_AbsoluteSetButtons, true);
+#if !HAS_KSTYLE
+    table.set(QStyle::SH_Menu_SubMenuSloppyCloseTimeout, 300);
+    table.set(QStyle::SH_ScrollBar_LeftClickAbsolutePosition, true);
+    table.set(QStyle::SH_ToolButtonStyle, Qt::ToolButtonTextBesideIcon);
+#endif
+    return table;
+}();
+
+}  // namespace Lilac
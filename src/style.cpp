@@ -1,16 +1,20 @@
 // SPDX-License-Identifier: GPL-3.0-or-later
 // SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
 
+#include <QAbstractScrollArea>
+#include <QApplication>
 #include <QDial>
 #include <QDockWidget>
 #include <QFocusFrame>
-#include <QGraphicsDropShadowEffect>
-#include <QMenu>
+#include <QGuiApplication>
 #include <QPaintEvent>
 #include <QPainter>
 #include <QPainterPath>
 #include <QPalette>
+#include <QScreen>
+#include <QScrollBar>
 #include <QStyleFactory>
+#include <QTimer>
 #include <QtMath>
 
 #if HAS_QTQUICK
@@ -19,12 +23,38 @@
 
 #include "animation_manager.h"
 #include "colors.h"
+#include "static_metrics.h"
 #include "style.h"
+#include "utils/icon_effects.h"
+#include "utils/pixmap_cache.h"
+#include "utils/shadow.h"
+#include "utils/shape_rasterizer.h"
 #include "utils/slider_focus_frame.h"
+#include "utils/widget_kind.h"
 
 namespace Lilac {
 
-Style::Style() : config(Config::get()) {
+Style::Style()
+    : config(Config::get()),
+      windowMgr(&eventDispatcher),
+      translucencyMgr()
+#if HAS_KWINDOWSYSTEM
+      ,
+      blurMgr(&eventDispatcher)
+#endif
+#if HAS_X11
+      ,
+      opaqueRegionMgr(&eventDispatcher)
+#endif
+{
+    eventDispatcher.setHandler(EventDispatcher::ComboPopup, this);
+    updateMetrics();
+    connect(&config, &Config::configChanged, this, &Style::updateMetrics);
+    connect(&config, &Config::configChanged, this, &invalidateBrushesAndPens);
+
+    // the caches are filled once the event loop runs, so that the startup is not delayed
+    QTimer::singleShot(0, this, &Style::prewarmCaches);
+    connect(qGuiApp, &QGuiApplication::screenRemoved, this, [this](QScreen* screen) { pixmapCache.pruneDevicePixelRatios(screen); });
 #if HAS_KSTYLE
     kstyle_CE_CapacityBar = newControlElement("CE_CapacityBar");
 #endif
@@ -41,6 +71,25 @@ void Style::drawComplexControl(QStyle::ComplexControl control, const QStyleOptio
         case CC_ScrollBar:
             if (const auto* bar = qstyleoption_cast<const QStyleOptionSlider*>(opt)) {
                 const bool horizontal = bar->state & QStyle::State_Horizontal;
+
+                if (config.scrollBarOverlay) {
+                    // only the slider is drawn, fading in and out, nothing below the scrollbar has to change
+                    const qreal opacity = scrollBarOverlayOpacity(bar, widget);
+                    if (opacity <= 0) {
+                        return;
+                    }
+
+                    const int padding = state.hovered || (bar->state & QStyle::State_Sunken) ? config.scrollBarOverlaySliderPaddingHover : config.scrollBarOverlaySliderPadding;
+                    const QRectF rect = QRectF(subControlRect(control, opt, SC_ScrollBarSlider, widget)).adjusted(padding, padding, -padding, -padding);
+                    const qreal cornerRadius = (horizontal ? rect.height() : rect.width()) / 2.0;
+
+                    p->save();
+                    p->setOpacity(opacity);
+                    fillRoundedRect(p, rect, cornerRadius, getBrush(bar->palette, Color::scrollBarSlider, state).color());
+                    p->restore();
+                    return;
+                }
+
                 const bool showGroove = state.hovered && state.enabled;
                 const int defaultThickness = horizontal ? bar->rect.height() : bar->rect.width();
 
@@ -69,9 +118,7 @@ void Style::drawComplexControl(QStyle::ComplexControl control, const QStyleOptio
                     }
                     p->restore();
                 }
-                QStyleOptionSlider barOpt = *bar;
-                barOpt.rect = subControlRect(control, opt, SC_ScrollBarSlider, widget);
-                drawControl(QStyle::CE_ScrollBarSlider, &barOpt, p, widget);
+                drawScrollBarSlider(p, subControlRect(control, opt, SC_ScrollBarSlider, widget), horizontal, state, bar->palette, widget);
                 return;
             }
             break;
@@ -80,61 +127,26 @@ void Style::drawComplexControl(QStyle::ComplexControl control, const QStyleOptio
                 const QRect grooveRect = subControlRect(QStyle::CC_Slider, slider, QStyle::SC_SliderGroove, widget);
                 const QRect handleRect = subControlRect(QStyle::CC_Slider, slider, QStyle::SC_SliderHandle, widget);
 
-                const int handleLen = slider->orientation == Qt::Horizontal ? handleRect.width() : handleRect.height();
-
-                p->save();
-                p->setRenderHint(QPainter::Antialiasing);
-
-                if (slider->orientation == Qt::Horizontal) {
-                    if (slider->upsideDown) {
-                        p->setPen(getPen(slider->palette, sliderLineAfter, state, 2));
-                    } else {
-                        p->setPen(getPen(slider->palette, sliderLineBefore, state, 2));
-                    }
-                    p->drawLine(grooveRect.left() + (handleLen / 2),
-                                grooveRect.center().y() + 1,
-                                handleRect.center().x(),
-                                grooveRect.center().y() + 1);
-
-                    if (slider->upsideDown) {
-                        p->setPen(getPen(slider->palette, sliderLineBefore, state, 2));
-                    } else {
-                        p->setPen(getPen(slider->palette, sliderLineAfter, state, 2));
-                    }
-                    p->drawLine(handleRect.center().x(),
-                                grooveRect.center().y() + 1,
-                                grooveRect.right() - (handleLen / 2),
-                                grooveRect.center().y() + 1);
-                } else {
-                    if (slider->upsideDown) {
-                        p->setPen(getPen(slider->palette, sliderLineAfter, state, 2));
-                    } else {
-                        p->setPen(getPen(slider->palette, sliderLineBefore, state, 2));
-                    }
-                    p->drawLine(grooveRect.center().x() + 1,
-                                grooveRect.top() + (handleLen / 2),
-                                grooveRect.center().x() + 1,
-                                handleRect.center().y());
-
-                    if (slider->upsideDown) {
-                        p->setPen(getPen(slider->palette, sliderLineBefore, state, 2));
-                    } else {
-                        p->setPen(getPen(slider->palette, sliderLineAfter, state, 2));
-                    }
-                    p->drawLine(grooveRect.center().x() + 1,
-                                handleRect.center().y(),
-                                grooveRect.center().x() + 1,
-                                grooveRect.bottom() - (handleLen / 2));
-                }
-
-                if (slider->subControls & SC_SliderTickmarks) {
-                    // ------------ tickmarks
+                const bool horizontal = slider->orientation == Qt::Horizontal;
+                const bool hasTickmarks = slider->subControls & SC_SliderTickmarks;
+                const int handleLen = horizontal ? handleRect.width() : handleRect.height();
+
+                // the line is split at the center of the handle
+                const Color startColor = slider->upsideDown ? sliderLineAfter : sliderLineBefore;
+                const Color endColor = slider->upsideDown ? sliderLineBefore : sliderLineAfter;
+                const QLine startLine = horizontal ?
+                                            QLine(grooveRect.left() + (handleLen / 2), grooveRect.center().y() + 1, handleRect.center().x(), grooveRect.center().y() + 1) :
+                                            QLine(grooveRect.center().x() + 1, grooveRect.top() + (handleLen / 2), grooveRect.center().x() + 1, handleRect.center().y());
+                const QLine endLine = horizontal ?
+                                          QLine(handleRect.center().x(), grooveRect.center().y() + 1, grooveRect.right() - (handleLen / 2), grooveRect.center().y() + 1) :
+                                          QLine(grooveRect.center().x() + 1, handleRect.center().y(), grooveRect.center().x() + 1, grooveRect.bottom() - (handleLen / 2));
+
+                const auto drawTickmarks = [&](QPainter* painter) {
                     int interval = slider->tickInterval;
                     if (interval <= 0)
                         interval = 10;
                     QList<QLine> lines;
                     if (slider->tickPosition == QSlider::TicksBothSides) {
-                        QStyleOptionSlider customOpt(*slider);
                         QRect tickmarksRect = subControlRect(QStyle::CC_Slider, slider, QStyle::SC_SliderTickmarks, widget);
                         // tickmarksRect is initially the bottom/right one and then gets moved to the top
 
@@ -142,7 +154,7 @@ void Style::drawComplexControl(QStyle::ComplexControl control, const QStyleOptio
                         this->sliderGetTickmarks(&lines, slider, tickmarksRect, handleLen, interval);
 
                         // top/left ticks
-                        if (slider->orientation == Qt::Horizontal) {
+                        if (horizontal) {
                             tickmarksRect.moveTop(slider->rect.top());
                         } else {
                             tickmarksRect.moveLeft(slider->rect.left());
@@ -153,11 +165,78 @@ void Style::drawComplexControl(QStyle::ComplexControl control, const QStyleOptio
                         const QRect tickmarksRect = subControlRect(QStyle::CC_Slider, slider, QStyle::SC_SliderTickmarks, widget);
                         this->sliderGetTickmarks(&lines, slider, tickmarksRect, handleLen, interval);
                     }
-                    p->setRenderHint(QPainter::Antialiasing, false);
-                    p->setPen(getPen(slider->palette, sliderTickmarks, state, 1));
-                    p->drawLines(lines);
-                    p->setRenderHint(QPainter::Antialiasing);
+                    painter->setRenderHint(QPainter::Antialiasing, false);
+                    painter->setPen(getPen(slider->palette, sliderTickmarks, state, 1));
+                    painter->drawLines(lines);
+                    painter->setRenderHint(QPainter::Antialiasing);
+                };
+
+                p->save();
+                p->setRenderHint(QPainter::Antialiasing);
+
+                if (PixmapCache::canBlit(p) && !slider->rect.isEmpty()) {
+                    // the whole line in the end color and the tickmarks do not change with the value,
+                    // so they are prerendered and only the start part of the line is drawn over them
+                    const qreal dpr = p->device()->devicePixelRatioF();
+                    const QPen endPen = getPen(slider->palette, endColor, state, 2);
+                    const QColor tickmarksColor = getColor(slider->palette, sliderTickmarks, state);
+                    const QLine fullLine(startLine.p1(), endLine.p2());
+                    const QPoint origin = slider->rect.topLeft();
+                    const PixmapCache::Placement placement = PixmapCache::placement(p, origin);
+                    const PixmapCache::Key key = PixmapCache::key(PixmapCache::SliderBackground,
+                                                                  placement.phaseKey,
+                                                                  slider->rect.width(),
+                                                                  slider->rect.height(),
+                                                                  fullLine.x1() - origin.x(),
+                                                                  fullLine.y1() - origin.y(),
+                                                                  fullLine.x2() - origin.x(),
+                                                                  fullLine.y2() - origin.y(),
+                                                                  int(slider->orientation),
+                                                                  int(slider->upsideDown),
+                                                                  int(hasTickmarks),
+                                                                  int(slider->tickPosition),
+                                                                  slider->tickInterval,
+                                                                  slider->minimum,
+                                                                  slider->maximum,
+                                                                  endPen.color().rgba(),
+                                                                  tickmarksColor.rgba());
+                    QPixmap pixmap;
+                    if (!pixmapCache.find(key, dpr, &pixmap)) {
+                        pixmap = QPixmap::fromImage(PixmapCache::render(slider->rect.size(), dpr, placement.phase, [&](QPainter* painter) {
+                            painter->translate(-origin);
+                            painter->setRenderHint(QPainter::Antialiasing);
+                            painter->setPen(endPen);
+                            painter->drawLine(fullLine);
+                            if (hasTickmarks) {
+                                drawTickmarks(painter);
+                            }
+                        }));
+                        pixmapCache.insert(key, dpr, pixmap);
+                    }
 
+                    // the line is 2px wide and pixel aligned, so the start part covers exactly this band
+                    const QRect startBand = horizontal ?
+                                                QRect(QPoint(slider->rect.left(), startLine.y1() - 1), QPoint(startLine.x2(), startLine.y1())) :
+                                                QRect(QPoint(startLine.x1() - 1, slider->rect.top()), QPoint(startLine.x1(), startLine.y2()));
+                    p->save();
+                    p->setClipRegion(QRegion(slider->rect).subtracted(startBand), Qt::IntersectClip);
+                    p->drawPixmap(placement.position, pixmap);
+                    p->restore();
+
+                    p->setPen(getPen(slider->palette, startColor, state, 2));
+                    p->drawLine(startLine);
+                } else {
+                    p->setPen(getPen(slider->palette, startColor, state, 2));
+                    p->drawLine(startLine);
+                    p->setPen(getPen(slider->palette, endColor, state, 2));
+                    p->drawLine(endLine);
+
+                    if (hasTickmarks) {
+                        drawTickmarks(p);
+                    }
+                }
+
+                if (hasTickmarks) {
                     // ------------- handle
                     const QRectF handleRectF(handleRect);
                     const qreal handleRadius = handleRectF.height() / 2.0;
@@ -275,7 +354,7 @@ void Style::drawComplexControl(QStyle::ComplexControl control, const QStyleOptio
                 bool noBackground = false;
                 if (widget) {
                     if (const QWidget* parent = widget->parentWidget()) {
-                        if (parent->inherits("DolphinUrlNavigator")) {
+                        if (widgetKinds(parent).testFlag(WidgetKind::DolphinUrlNavigator)) {
                             noBackground = true;
                         }
                     }
@@ -382,9 +461,7 @@ void Style::drawComplexControl(QStyle::ComplexControl control, const QStyleOptio
                 }
 
                 if (hasCheck) {
-                    QStyleOption checkOpt = *box;
-                    checkOpt.rect = checkRect;
-                    drawPrimitive(PE_IndicatorCheckBox, &checkOpt, p, widget);
+                    drawCheckIndicator(p, checkRect, checkIndicator(false, box->state, box->palette));
                 }
 
                 if (hasLabel) {
@@ -420,20 +497,74 @@ void Style::drawComplexControl(QStyle::ComplexControl control, const QStyleOptio
                 p->save();
                 p->setRenderHint(QPainter::Antialiasing);
 
-                p->setBrush(Qt::NoBrush);
-                if (dial->upsideDown) {
-                    p->setPen(getPen(dial->palette, Color::dialLineAfter, state, 2));
-                    p->drawArc(sliderRect, -90 * 16 + startAngle * 16, value * 16);
-                    p->setPen(getPen(dial->palette, Color::dialLineBefore, state, 2));
-                    p->drawArc(sliderRect, 270 * 16 - startAngle * 16, (value - arcLen) * 16);
+                if (PixmapCache::canBlit(p) && !groove.isEmpty()) {
+                    // the whole arc is prerendered in both colors, and each is clipped to its side of the handle,
+                    // the clips reach into the middle of the gap, so that the pen caps at the ends are kept
+                    const qreal dpr = p->device()->devicePixelRatioF();
+                    const PixmapCache::Placement placement = PixmapCache::placement(p, groove.topLeft());
+                    const auto ring = [&](const Color color) {
+                        const QPen pen = getPen(dial->palette, color, state, 2);
+                        const PixmapCache::Key key = PixmapCache::key(PixmapCache::DialRing,
+                                                                      placement.phaseKey,
+                                                                      groove.width(),
+                                                                      arcLen,
+                                                                      config.dialHandleDiameter,
+                                                                      pen.color().rgba());
+                        QPixmap pixmap;
+                        if (!pixmapCache.find(key, dpr, &pixmap)) {
+                            pixmap = QPixmap::fromImage(PixmapCache::render(groove.size(), dpr, placement.phase, [&](QPainter* painter) {
+                                painter->setRenderHint(QPainter::Antialiasing);
+                                painter->setPen(pen);
+                                painter->setBrush(Qt::NoBrush);
+                                painter->drawArc(sliderRect.translated(-groove.topLeft()), -90 * 16 + startAngle * 16, arcLen * 16);
+                            }));
+                            pixmapCache.insert(key, dpr, pixmap);
+                        }
+                        return pixmap;
+                    };
+                    const auto sector = [&](const qreal start, const qreal span) {
+                        // larger than the groove, so that no antialiased edge of the arc is cut off
+                        const QRectF rect = groove.toRectF().adjusted(-groove.width(), -groove.height(), groove.width(), groove.height());
+                        QPainterPath path;
+                        path.moveTo(rect.center());
+                        path.arcTo(rect, start, span);
+                        path.closeSubpath();
+                        return path;
+                    };
+
+                    const qreal gapHalf = (360 - arcLen) / 2.0;
+                    const qreal split = -90 + startAngle + value;
+                    const QPainterPath afterSector = sector(-90 + startAngle - gapHalf, value + gapHalf);
+                    const QPainterPath beforeSector = sector(split, arcLen - value + gapHalf);
+
+                    p->save();
+                    p->setClipPath(afterSector, Qt::IntersectClip);
+                    p->drawPixmap(placement.position, ring(Color::dialLineAfter));
+                    p->restore();
+                    p->save();
+                    p->setClipPath(beforeSector, Qt::IntersectClip);
+                    p->drawPixmap(placement.position, ring(Color::dialLineBefore));
+                    p->restore();
                 } else {
-                    p->setPen(getPen(dial->palette, Color::dialLineBefore, state, 2));
-                    p->drawArc(sliderRect, 270 * 16 - startAngle * 16, (value - arcLen) * 16);
-                    p->setPen(getPen(dial->palette, Color::dialLineAfter, state, 2));
-                    p->drawArc(sliderRect, -90 * 16 + startAngle * 16, value * 16);
+                    p->setBrush(Qt::NoBrush);
+                    if (dial->upsideDown) {
+                        p->setPen(getPen(dial->palette, Color::dialLineAfter, state, 2));
+                        p->drawArc(sliderRect, -90 * 16 + startAngle * 16, value * 16);
+                        p->setPen(getPen(dial->palette, Color::dialLineBefore, state, 2));
+                        p->drawArc(sliderRect, 270 * 16 - startAngle * 16, (value - arcLen) * 16);
+                    } else {
+                        p->setPen(getPen(dial->palette, Color::dialLineBefore, state, 2));
+                        p->drawArc(sliderRect, 270 * 16 - startAngle * 16, (value - arcLen) * 16);
+                        p->setPen(getPen(dial->palette, Color::dialLineAfter, state, 2));
+                        p->drawArc(sliderRect, -90 * 16 + startAngle * 16, value * 16);
+                    }
                 }
 
-                QRect handleRect = subControlRect(CC_Dial, dial, SC_DialHandle, widget);
+                const QRect handleRect = subControlRect(CC_Dial, dial, SC_DialHandle, widget);
+                // the focus frame is drawn right after this, it reuses the rect instead of computing it again
+                if (widget && widgetKindCache.contains(widget)) {
+                    dialHandleRects.insert(widget, {dial->rect, dial->sliderPosition, handleRect});
+                }
 
                 p->setPen(Qt::NoPen);
                 p->setBrush(getBrush(dial->palette, Color::dialHandle, state));
@@ -544,129 +675,48 @@ void Style::drawControl(QStyle::ControlElement element, const QStyleOption* opt,
             if (const auto* tab = qstyleoption_cast<const QStyleOptionTab*>(opt)) {
                 const bool isSelected = tab->state & QStyle::State_Selected;
 
-                if ((!isSelected && !state.hasFocus && !state.pressed && !state.hovered) || (!state.enabled && !isSelected)) {
+                if ((!isSelected && !state.hasFocus && !state.pressed && !state.hovered) || (!state.enabled && !isSelected) || tab->rect.isEmpty()) {
                     return;
                 }
 
-                QRectF rect = tab->rect.toRectF();
-                qreal cornerRectSize;
-                switch (tab->shape) {
-                    case QTabBar::RoundedNorth:
-                    case QTabBar::TriangularNorth:
-                    case QTabBar::RoundedSouth:
-                    case QTabBar::TriangularSouth:
-                        cornerRectSize = qMin(config.tabCornerRadius * 2.0,  // the corner radius is still cornerRadius,
-                                              qMin(rect.width(),             // it has to be *2 because this reqires the diameter
-                                                   rect.height() * 2));
-
-                        break;
-
-                    case QTabBar::RoundedEast:
-                    case QTabBar::TriangularEast:
-                    case QTabBar::RoundedWest:
-                    case QTabBar::TriangularWest:
-                        cornerRectSize = qMin(config.tabCornerRadius * 2.0,
-                                              qMin(rect.height(),
-                                                   rect.width() * 2));
-                        break;
+                const bool outlined = isSelected || state.hasFocus;
+                const QPen pen = outlined ? getPen(tab->palette, Color::tabCheckedOutline, state, 1) : QPen(Qt::NoPen);
+                const QBrush brush = getBrush(tab->palette, outlined ? Color::tabCheckedFill : Color::tabUncheckedHover, state);
+                const auto drawShape = [&](QPainter* painter, const QRectF& rect) {
+                    painter->setRenderHints(QPainter::Antialiasing);
+                    painter->setPen(pen);
+                    painter->setBrush(brush);
+                    painter->drawPath(tabShapePath(rect, tab->shape, isSelected));
                 };
 
-                QPainterPath path;
-                switch (tab->shape) {
-                    case QTabBar::RoundedNorth:
-                    case QTabBar::TriangularNorth:
-                        rect.adjust(0.5, 0.5, -0.5, isSelected ? 0 : -1.5);
-
-                        path.moveTo(rect.bottomLeft());
-                        path.lineTo(rect.left(), rect.top() + config.tabCornerRadius);
-                        path.arcTo(QRectF(
-                                       rect.topLeft(),
-                                       QPointF(rect.left() + cornerRectSize, rect.top() + cornerRectSize)),
-                                   180,
-                                   -90);
-                        path.lineTo(rect.right() - config.tabCornerRadius, rect.top());
-                        path.arcTo(QRectF(
-                                       rect.topRight(),
-                                       QPointF(rect.right() - cornerRectSize, rect.top() + cornerRectSize)),
-                                   90,
-                                   90);
-                        path.lineTo(rect.bottomRight());
-                        break;
-
-                    case QTabBar::RoundedSouth:
-                    case QTabBar::TriangularSouth:
-                        rect.adjust(0.5, isSelected ? 0 : 1.5, -0.5, -0.5);
-
-                        path.moveTo(rect.topLeft());
-                        path.lineTo(rect.left(), rect.bottom() - config.tabCornerRadius);
-                        path.arcTo(QRectF(
-                                       rect.bottomLeft(),
-                                       QPointF(rect.left() + cornerRectSize, rect.bottom() - cornerRectSize)),
-                                   180,
-                                   -90);
-                        path.lineTo(rect.right() - config.tabCornerRadius, rect.bottom());
-                        path.arcTo(QRectF(
-                                       rect.bottomRight(),
-                                       QPointF(rect.right() - cornerRectSize, rect.bottom() - cornerRectSize)),
-                                   90,
-                                   90);
-                        path.lineTo(rect.topRight());
-                        break;
-
-                    case QTabBar::RoundedWest:
-                    case QTabBar::TriangularWest:
-                        rect.adjust(0.5, 0.5, isSelected ? 0 : -1.5, -0.5);
-
-                        path.moveTo(rect.topRight());
-                        path.lineTo(rect.left() + config.tabCornerRadius, rect.top());
-                        path.arcTo(QRectF(
-                                       rect.topLeft(),
-                                       QPointF(rect.left() + cornerRectSize, rect.top() + cornerRectSize)),
-                                   90,
-                                   90);
-                        path.lineTo(rect.left(), rect.bottom() - config.tabCornerRadius);
-                        path.arcTo(QRectF(
-                                       rect.bottomLeft(),
-                                       QPointF(rect.left() + cornerRectSize, rect.bottom() - cornerRectSize)),
-                                   180,
-                                   -90);
-                        path.lineTo(rect.bottomRight());
-                        break;
-
-                    case QTabBar::RoundedEast:
-                    case QTabBar::TriangularEast:
-                        rect.adjust(isSelected ? 0 : 1.5, 0.5, -0.5, -0.5);
-
-                        path.moveTo(rect.topLeft());
-                        path.lineTo(rect.right() - config.tabCornerRadius, rect.top());
-                        path.arcTo(QRectF(
-                                       rect.topRight(),
-                                       QPointF(rect.right() - cornerRectSize, rect.top() + cornerRectSize)),
-                                   90,
-                                   90);
-                        path.lineTo(rect.right(), rect.bottom() - config.tabCornerRadius);
-                        path.arcTo(QRectF(
-                                       rect.bottomRight(),
-                                       QPointF(rect.right() - cornerRectSize, rect.bottom() - cornerRectSize)),
-                                   180,
-                                   -90);
-                        path.lineTo(rect.bottomLeft());
-                        break;
-                }
-                p->save();
-                p->setRenderHints(QPainter::Antialiasing);
-
-                if (isSelected || state.hasFocus) {
-                    p->setPen(getPen(tab->palette, Color::tabCheckedOutline, state, 1));
-                    p->setBrush(getBrush(tab->palette, Color::tabCheckedFill, state));
-                    p->drawPath(path);
-                } else {
-                    p->setPen(Qt::NoPen);
-                    p->setBrush(getBrush(tab->palette, Color::tabUncheckedHover, state));
-                    p->drawPath(path);
+                if (!PixmapCache::canBlit(p)) {
+                    p->save();
+                    drawShape(p, tab->rect.toRectF());
+                    p->restore();
+                    return;
                 }
 
-                p->restore();
+                // all tabs get repainted on hover and while dragging, so the shape is prerendered
+                const qreal dpr = p->device()->devicePixelRatioF();
+                const PixmapCache::Placement placement = PixmapCache::placement(p, tab->rect.topLeft());
+                const PixmapCache::Key key = PixmapCache::key(PixmapCache::TabShape,
+                                                              placement.phaseKey,
+                                                              int(tab->shape),
+                                                              tab->rect.width(),
+                                                              tab->rect.height(),
+                                                              int(isSelected),
+                                                              int(outlined),
+                                                              config.tabCornerRadius,
+                                                              brush.color().rgba(),
+                                                              pen.color().rgba());
+                QPixmap pixmap;
+                if (!pixmapCache.find(key, dpr, &pixmap)) {
+                    pixmap = QPixmap::fromImage(PixmapCache::render(tab->rect.size(), dpr, placement.phase, [&](QPainter* painter) {
+                        drawShape(painter, QRectF(QPointF(0, 0), tab->rect.size()));
+                    }));
+                    pixmapCache.insert(key, dpr, pixmap);
+                }
+                p->drawPixmap(placement.position, pixmap);
                 return;
             }
             break;
@@ -687,14 +737,14 @@ void Style::drawControl(QStyle::ControlElement element, const QStyleOption* opt,
 
                 // Icon
                 if (!tab->icon.isNull() && tab->iconSize.isValid()) {
-                    const QRect iconRect = tabBarTabIconRect(tab, state, textRect);
+                    const QRect iconRect = tabBarTabIconRect(tab, state, textRect, widget);
                     tab->icon.paint(p, iconRect, Qt::AlignCenter, state.enabled ? QIcon::Normal : QIcon::Disabled);
                 }
 
                 // Text
                 if (!tab->text.isEmpty()) {
                     p->setPen(getPen(tab->palette, Color::tabText, state));
-                    p->drawText(textRect, (getTextFlags(tab) | Qt::AlignLeft | Qt::AlignVCenter), tab->text);
+                    drawLabelText(p, textRect, (getTextFlags(tab) | Qt::AlignLeft | Qt::AlignVCenter), tab->text);
                 }
                 p->restore();
                 return;
@@ -707,36 +757,9 @@ void Style::drawControl(QStyle::ControlElement element, const QStyleOption* opt,
         case CE_ScrollBarSubLine:
             return;
 
-        case CE_ScrollBarSlider: {
-            const bool horizontal = opt->state & QStyle::State_Horizontal;
-            const int defaultThickness = horizontal ? opt->rect.height() : opt->rect.width();
-
-            const int normalThickness = defaultThickness - 2 * config.scrollBarSliderPadding;
-            const int hoverThickness = defaultThickness - 2 * config.scrollBarSliderPaddingHover;
-            const qreal animationProgress = animationMgr.getOnlyValue<qreal>(widget, state.enabled && state.hovered ? 1 : 0);
-
-            QRect originalRect;
-            QRectF rect;
-            if (horizontal) {
-                originalRect = opt->rect.adjusted(0, 1, 0, 0);  // the +1 is for the separator line above the hovered separator width
-                rect = originalRect;
-                rect.setHeight((hoverThickness - normalThickness) * animationProgress + normalThickness);
-            } else {
-                originalRect = opt->rect.adjusted(1, 0, 0, 0);
-                rect = originalRect;
-                rect.setWidth((hoverThickness - normalThickness) * animationProgress + normalThickness);
-            }
-            rect.moveCenter(originalRect.center());
-            p->save();
-            p->setRenderHints(QPainter::Antialiasing);
-            p->setPen(Qt::NoPen);
-            p->setBrush(getBrush(opt->palette, Color::scrollBarSlider, state));
-            const double cornerRadius = horizontal ? rect.height() / 2.0 : rect.width() / 2.0;
-            p->drawRoundedRect(rect, cornerRadius, cornerRadius);
-            p->restore();
-
+        case CE_ScrollBarSlider:
+            drawScrollBarSlider(p, opt->rect, opt->state & QStyle::State_Horizontal, state, opt->palette, widget);
             return;
-        }
 
         case CE_MenuItem:
             if (const auto* menu = qstyleoption_cast<const QStyleOptionMenuItem*>(opt)) {
@@ -757,12 +780,7 @@ void Style::drawControl(QStyle::ControlElement element, const QStyleOption* opt,
                                                                         0,
                                                                         -(config.menuItemHorizontalMargin),
                                                                         0);
-                            p->save();
-                            p->setRenderHints(QPainter::Antialiasing);
-                            p->setPen(Qt::NoPen);
-                            p->setBrush(getBrush(menu->palette, Color::menuItemHoverBg, state));
-                            p->drawRoundedRect(hoverRect, config.menuItemBorderRadius, config.menuItemBorderRadius);
-                            p->restore();
+                            fillRoundedRect(p, hoverRect, config.menuItemBorderRadius, getBrush(menu->palette, Color::menuItemHoverBg, state).color());
                         }
 
                         // checks
@@ -771,18 +789,9 @@ void Style::drawControl(QStyle::ControlElement element, const QStyleOption* opt,
                             checkSize = qMin(config.checkBoxSize, contentsRect.height());
 
                         if (menu->checkType != QStyleOptionMenuItem::NotCheckable) {
-                            QStyleOption checkOpt(*menu);
-                            checkOpt.rect = QRect(contentsRect.left(), contentsRect.top(), checkSize, contentsRect.height());
-                            if (menu->checked) {
-                                checkOpt.state |= QStyle::State_On;
-                                checkOpt.state &= ~QStyle::State_Off;
-                            } else {
-                                checkOpt.state |= QStyle::State_Off;
-                                checkOpt.state &= ~QStyle::State_On;
-                            }
-                            this->drawPrimitive(menu->checkType == QStyleOptionMenuItem::Exclusive ? QStyle::PE_IndicatorRadioButton :
-                                                                                                     QStyle::PE_IndicatorCheckBox,
-                                                &checkOpt, p, nullptr);
+                            const QRect checkRect(contentsRect.left(), contentsRect.top(), checkSize, contentsRect.height());
+                            const QStyle::State checkState = (menu->state & ~(QStyle::State_On | QStyle::State_Off)) | (menu->checked ? QStyle::State_On : QStyle::State_Off);
+                            drawCheckIndicator(p, checkRect, checkIndicator(menu->checkType == QStyleOptionMenuItem::Exclusive, checkState, menu->palette));
                         }
 
                         // icon
@@ -821,7 +830,7 @@ void Style::drawControl(QStyle::ControlElement element, const QStyleOption* opt,
                                 const QRect labelRect(QPoint(contentsRect.left() + leftElementsSize, contentsRect.top()), QPoint(contentsRect.right() - rightElementSize, contentsRect.bottom()));
 
                                 p->setPen(getPen(menu->palette, Color::menuText, state));
-                                p->drawText(labelRect, textFlags | Qt::AlignLeft | Qt::AlignVCenter, text.label);
+                                drawLabelText(p, labelRect, textFlags | Qt::AlignLeft | Qt::AlignVCenter, text.label);
                             }
 
                             // shortcut
@@ -833,17 +842,16 @@ void Style::drawControl(QStyle::ControlElement element, const QStyleOption* opt,
                                     shortcutRect.moveRight(contentsRect.right());
                                 }
                                 p->setPen(getPen(menu->palette, Color::menuShortcutText, state));
-                                p->drawText(shortcutRect, textFlags | Qt::AlignRight | Qt::AlignVCenter, text.shortcut);
+                                drawLabelText(p, shortcutRect, textFlags | Qt::AlignRight | Qt::AlignVCenter, text.shortcut);
                             }
                             p->restore();
                         }
 
                         // sub menu arrow
                         if (menu->menuItemType == QStyleOptionMenuItem::SubMenu) {
-                            QStyleOption arrowOpt(*menu);
-                            arrowOpt.rect = QRect(0, contentsRect.top(), config.smallArrowSize, contentsRect.height());
-                            arrowOpt.rect.moveRight(contentsRect.right());
-                            drawPrimitive(QStyle::PE_IndicatorArrowRight, &arrowOpt, p, widget);
+                            QRect arrowRect(0, contentsRect.top(), config.smallArrowSize, contentsRect.height());
+                            arrowRect.moveRight(contentsRect.right());
+                            drawIndicatorArrow(p, PE_IndicatorArrowRight, arrowRect, Lilac::State(menu->state), menu->palette, widget);
                         }
                         return;
                     }
@@ -1035,7 +1043,7 @@ void Style::drawControl(QStyle::ControlElement element, const QStyleOption* opt,
                     }
                 }
                 if (textRect.isValid() && !btn->text.isEmpty()) {
-                    p->drawText(textRect, (getTextFlags(btn) | textHalign | Qt::AlignVCenter), btn->text);
+                    drawLabelText(p, textRect, (getTextFlags(btn) | textHalign | Qt::AlignVCenter), btn->text);
                 }
                 p->restore();
 
@@ -1121,11 +1129,28 @@ void Style::drawControl(QStyle::ControlElement element, const QStyleOption* opt,
                 p->setPen(Qt::NoPen);
 
                 // groove
-                p->setBrush(getBrush(bar->palette, Color::progressBarIndicatorBg, state));
-                if (horizontal) {
-                    p->drawRoundedRect(bar->rect, bar->rect.height() / 2.0, bar->rect.height() / 2.0);
+                const QBrush grooveBrush = getBrush(bar->palette, Color::progressBarIndicatorBg, state);
+                const qreal grooveRadius = horizontal ? bar->rect.height() / 2.0 : bar->rect.width() / 2.0;
+                if (PixmapCache::canBlit(p) && !bar->rect.isEmpty()) {
+                    // the groove does not change with the progress, so it is prerendered
+                    const qreal dpr = p->device()->devicePixelRatioF();
+                    const PixmapCache::Placement placement = PixmapCache::placement(p, bar->rect.topLeft());
+                    const PixmapCache::Key key = PixmapCache::key(PixmapCache::ProgressBarGroove,
+                                                                  placement.phaseKey,
+                                                                  bar->rect.width(),
+                                                                  bar->rect.height(),
+                                                                  int(horizontal),
+                                                                  grooveBrush.color().rgba());
+                    QPixmap pixmap;
+                    if (!pixmapCache.find(key, dpr, &pixmap)) {
+                        pixmap = QPixmap::fromImage(PixmapCache::render(bar->rect.size(), dpr, placement.phase, [&](QPainter* painter) {
+                            fillRoundedRect(painter, QRect(QPoint(0, 0), bar->rect.size()), grooveRadius, grooveBrush.color());
+                        }));
+                        pixmapCache.insert(key, dpr, pixmap);
+                    }
+                    p->drawPixmap(placement.position, pixmap);
                 } else {
-                    p->drawRoundedRect(bar->rect, bar->rect.width() / 2.0, bar->rect.width() / 2.0);
+                    fillRoundedRect(p, bar->rect, grooveRadius, grooveBrush.color());
                 }
 
                 if (bar->progress <= 0 && bar->maximum > 0) {
@@ -1135,18 +1160,18 @@ void Style::drawControl(QStyle::ControlElement element, const QStyleOption* opt,
 
                 // busy indicator
                 if (busy) {
-                    p->setBrush(getBrush(bar->palette, Color::progressBarIndicator, state));
+                    const QColor indicatorColor = getBrush(bar->palette, Color::progressBarIndicator, state).color();
 
                     const qreal dashLen = (horizontal ? bar->rect.width() : bar->rect.height()) * Config::progressBarBusyIndicatorLen;
                     const qreal progress = widget ? animationMgr.getCurrentValue<qreal>(widget, 0.0, 2 * M_PI, config.progressBarBusyDuration, QVariantAnimation::Forward, true, true) : 0;
                     const qreal position = (qCos((progress) + M_PI) + 1) / 2.0;
 
                     if (horizontal) {
-                        p->drawRoundedRect(position * (bar->rect.width() - dashLen), bar->rect.top(), dashLen, bar->rect.height(),
-                                           bar->rect.height() / 2.0, bar->rect.height() / 2.0);
+                        fillRoundedRect(p, QRectF(position * (bar->rect.width() - dashLen), bar->rect.top(), dashLen, bar->rect.height()),
+                                        bar->rect.height() / 2.0, indicatorColor);
                     } else {
-                        p->drawRoundedRect(bar->rect.left(), position * (bar->rect.height() - dashLen), bar->rect.width(), dashLen,
-                                           bar->rect.width() / 2.0, bar->rect.width() / 2.0);
+                        fillRoundedRect(p, QRectF(bar->rect.left(), position * (bar->rect.height() - dashLen), bar->rect.width(), dashLen),
+                                        bar->rect.width() / 2.0, indicatorColor);
                     }
 
                     p->restore();
@@ -1177,11 +1202,11 @@ void Style::drawControl(QStyle::ControlElement element, const QStyleOption* opt,
                     }
                 }
 
-                p->setBrush(getBrush(bar->palette, Color::progressBarIndicator, state));
+                const QColor indicatorColor = getBrush(bar->palette, Color::progressBarIndicator, state).color();
                 if (horizontal) {
-                    p->drawRoundedRect(progressRect, bar->rect.height() / 2.0, bar->rect.height() / 2.0);
+                    fillRoundedRect(p, progressRect, bar->rect.height() / 2.0, indicatorColor);
                 } else {
-                    p->drawRoundedRect(progressRect, bar->rect.width() / 2.0, bar->rect.width() / 2.0);
+                    fillRoundedRect(p, progressRect, bar->rect.width() / 2.0, indicatorColor);
                 }
                 p->restore();
                 return;
@@ -1311,20 +1336,19 @@ void Style::drawControl(QStyle::ControlElement element, const QStyleOption* opt,
                 drawPrimitive(PE_PanelItemViewItem, opt, p, widget);
 
                 if (item->features & QStyleOptionViewItem::HasCheckIndicator) {
-                    QStyleOptionViewItem checkOpt = *item;
-                    checkOpt.rect = subElementRect(SE_ItemViewItemCheckIndicator, item, widget);
+                    QStyle::State checkState = item->state;
                     switch (item->checkState) {
                         case Qt::Unchecked:
-                            checkOpt.state |= State_Off;
+                            checkState |= State_Off;
                             break;
                         case Qt::Checked:
-                            checkOpt.state |= State_On;
+                            checkState |= State_On;
                             break;
                         case Qt::PartiallyChecked:
-                            checkOpt.state |= State_NoChange;
+                            checkState |= State_NoChange;
                             break;
                     }
-                    drawPrimitive(PE_IndicatorCheckBox, &checkOpt, p, widget);
+                    drawCheckIndicator(p, subElementRect(SE_ItemViewItemCheckIndicator, item, widget), checkIndicator(false, checkState, item->palette));
                 }
 
                 if (item->features & QStyleOptionViewItem::HasDecoration && !item->icon.isNull()) {
@@ -1379,7 +1403,10 @@ void Style::drawControl(QStyle::ControlElement element, const QStyleOption* opt,
                 dialOpt.upsideDown = !dial->invertedAppearance();
 
                 const qreal hoverRectDifference = (config.dialHandleHoverCircleDiameter - config.dialHandleDiameter) / 2.0;
-                const QRect handleRect = subControlRect(CC_Dial, &dialOpt, SC_DialHandle, dial);
+                const auto cachedHandle = dialHandleRects.constFind(dial);
+                const QRect handleRect = (cachedHandle != dialHandleRects.constEnd() && cachedHandle->dialRect == dial->rect() && cachedHandle->sliderPosition == dialOpt.sliderPosition) ?
+                                             cachedHandle->handleRect :
+                                             subControlRect(CC_Dial, &dialOpt, SC_DialHandle, dial);
                 const QRectF handleHoverRect = handleRect.toRectF().adjusted(-hoverRectDifference, -hoverRectDifference, hoverRectDifference, hoverRectDifference);
 
                 p->save();
@@ -1494,81 +1521,10 @@ void Style::drawPrimitive(QStyle::PrimitiveElement element, const QStyleOption*
             return;
 
         case PE_IndicatorCheckBox:
-        case PE_IndicatorRadioButton: {
-            const int indicatorSize = qMin(config.checkBoxSize, qMin(opt->rect.height() - 1, opt->rect.width()) - 1);
-            const int roundedCornerRaduis = (element == QStyle::PE_IndicatorCheckBox && !config.circleCheckBox) ? (config.checkBoxCornerRadius) : -1;  // the corner radius for checkboxes, if -1 then draw a circle
-
-            QRect indicatorRect = QRect(0, 0, indicatorSize, indicatorSize);
-            indicatorRect.moveCenter(opt->rect.center());
-
-            p->save();
-            p->setRenderHints(QPainter::Antialiasing);
-
-            if (state.hovered && state.enabled) {
-                const int size = qMin(config.checkBoxHoverCircleSize, qMin(opt->rect.height(), opt->rect.width()));
-                QRect hoverRect(0, 0, size, size);
-                hoverRect.moveCenter(opt->rect.center());
-
-                p->setPen(Qt::NoPen);
-                p->setBrush(getBrush(opt->palette,
-                                     (opt->state & State_Off) ? Color::checkBoxHoverCircle : Color::checkBoxHoverCircleChecked,
-                                     state));
-                p->drawEllipse(hoverRect);
-            }
-
-            if (opt->state & (QStyle::State_Off)) {
-                p->setPen(getPen(opt->palette, Color::checkBoxOutline, state, 2));
-                p->setBrush(Qt::NoBrush);
-                if (roundedCornerRaduis >= 0) {
-                    p->drawRoundedRect(indicatorRect.adjusted(1, 1, -1, -1), qMax(roundedCornerRaduis - 1, 0), qMax(roundedCornerRaduis - 1, 0));
-                } else {
-                    p->drawEllipse(indicatorRect.adjusted(1, 1, -1, -1));
-                }
-                p->restore();
-                return;
-            }
-
-            p->setPen(Qt::NoPen);
-            p->setBrush(getBrush(opt->palette, Color::checkBoxInside, state));
-            if (roundedCornerRaduis >= 0) {
-                p->drawRoundedRect(indicatorRect, roundedCornerRaduis, roundedCornerRaduis);
-            } else {
-                p->drawEllipse(indicatorRect);
-            }
-
-            if (element == QStyle::PE_IndicatorCheckBox) {
-                p->setPen(getPen(opt->palette, Color::checkBoxCheck, state, 2));
-                p->setBrush(Qt::NoBrush);
-
-                const double widthOffset = opt->rect.width() - indicatorSize;
-
-                if (opt->state & QStyle::State_NoChange) {
-                    const double adjustment = indicatorSize / 4.0f;
-                    const double y = opt->rect.center().y() + 1;
-
-                    p->drawLine(QLineF(opt->rect.left() + widthOffset + adjustment + 1, y, opt->rect.right() - widthOffset - adjustment, y));
-
-                } else {
-                    const auto center = opt->rect.center();
-                    const QPointF points[3] = {
-                        QPointF(center.x() - indicatorSize / 4.0, center.y()),
-                        QPointF(center.x() - indicatorSize / 10.0, center.y() + indicatorSize / 5.0),
-                        QPointF(center.x() + indicatorSize / 4.0, center.y() - indicatorSize / 7.5),
-                    };
-
-                    p->drawPolyline(points, 3);
-                }
-            } else {
-                const double adjustment = indicatorSize * 0.35;
-
-                p->setPen(Qt::NoPen);
-                p->setBrush(getBrush(opt->palette, Color::checkBoxCheck, state));
-                p->drawEllipse(indicatorRect.toRectF().adjusted(adjustment, adjustment, -adjustment, -adjustment));
-            }
-
-            p->restore();
+        case PE_IndicatorRadioButton:
+            drawCheckIndicator(p, opt->rect, checkIndicator(element == PE_IndicatorRadioButton, opt->state, opt->palette));
             return;
-        }
+
         case PE_FrameTabWidget: {
             QRectF rect = opt->rect.toRectF().adjusted(.5, .5, -.5, -.5);
             p->save();
@@ -1584,7 +1540,7 @@ void Style::drawPrimitive(QStyle::PrimitiveElement element, const QStyleOption*
             p->save();
             p->setBrush(Qt::NoBrush);
             p->setPen(getPen(opt->palette, Color::tabCheckedOutline, 1));
-            if (widget && widget->inherits("DolphinTabBar")) {
+            if (widgetKinds(widget).testFlag(WidgetKind::DolphinTabBar)) {
                 p->fillRect(opt->rect, getColor(opt->palette, Color::toolBarBgHeader, state));
                 p->drawLine(opt->rect.topLeft(), opt->rect.bottomLeft());
                 p->drawLine(opt->rect.topRight(), opt->rect.bottomRight());
@@ -1627,7 +1583,7 @@ void Style::drawPrimitive(QStyle::PrimitiveElement element, const QStyleOption*
                     this->drawPrimitive(PE_FrameLineEdit, edit, p, widget);
                     return;
                 }
-                if (widget && widget->parentWidget() && (widget->parentWidget()->inherits("QComboBox") || widget->parentWidget()->inherits("QAbstractSpinBox"))) {
+                if (widget && widgetKinds(widget->parentWidget()).testAnyFlags(WidgetKind::ComboBox | WidgetKind::AbstractSpinBox)) {
                     return;
                 }
                 SuperStyle::drawPrimitive(PE_PanelLineEdit, opt, p);
@@ -1678,7 +1634,7 @@ void Style::drawPrimitive(QStyle::PrimitiveElement element, const QStyleOption*
             }
             break;
         case PE_PanelMenu: {
-            const bool isQMenu = widget && widget->inherits("QMenu");
+            const bool isQMenu = widgetKinds(widget).testFlag(WidgetKind::Menu);
             const QRect contentRect = opt->rect.adjusted(config.menuMargin,
                                                          config.menuMargin,
                                                          -config.menuMargin,
@@ -1686,11 +1642,15 @@ void Style::drawPrimitive(QStyle::PrimitiveElement element, const QStyleOption*
 
             if (isQMenu) {
                 p->save();
-                p->setCompositionMode(QPainter::CompositionMode_Clear);
-                p->fillRect(opt->rect, Qt::transparent);
+                if (TranslucencyManager::hasAlphaChannel(widget)) {
+                    p->setCompositionMode(QPainter::CompositionMode_Clear);
+                    p->fillRect(opt->rect, Qt::transparent);
+                } else {
+                    p->fillRect(opt->rect, opt->palette.window());  // without a compositor the margin would be black
+                }
                 p->restore();
 
-                drawDropShadow(p, contentRect, config.menuBorderRadius, config.menuShadowBlurRadius, config.menuShadowOffset, getColor(opt->palette, Color::menuShadow));
+                drawRoundedRectShadow(p, &pixmapCache, contentRect, config.menuBorderRadius, config.menuShadowBlurRadius, config.menuShadowOffset, getColor(opt->palette, Color::menuShadow));
             }
 
             p->save();
@@ -1913,70 +1873,9 @@ void Style::drawPrimitive(QStyle::PrimitiveElement element, const QStyleOption*
         case PE_IndicatorArrowUp:
         case PE_IndicatorArrowDown:
         case PE_IndicatorArrowLeft:
-        case PE_IndicatorArrowRight: {
-            int size = qMin(opt->rect.width(), opt->rect.height());
-            // size of the top naviagtion arrows in dolphin
-            if (widget && widget->inherits("KDEPrivate::KUrlNavigatorButtonBase")) {
-                size = qMin(config.dolphinUrlNavigatorArrowSize, size);
-            }
-            const int tipOffset = size % 2;
-            /* tipOffset: is so for odd size rect the arrow is is still symetrical
-             * e.g for the down arrow:
-             * if the width of the rect is odd the tip's x would not be a whole number,
-             * so instead of a recangle I draw a trapezoid with the tip being 2px long
-             * because trapezoid has 4 sides, in p->drawPolygon I do 4 if trapezoid and 3
-             * if triangle.
-             */
-
-            int width = 0;
-            int height = 0;
-            if (element == PE_IndicatorArrowUp || element == PE_IndicatorArrowDown) {
-                width = size;
-                height = size / 2;
-            } else {
-                height = size;
-                width = size / 2;
-            }
-
-            QPoint points[4];
-            switch (element) {
-                case PE_IndicatorArrowUp:
-                    points[0] = QPoint(0, height);
-                    points[1] = QPoint(width, height);
-                    points[2] = QPoint(width / 2, 0);
-                    points[3] = QPoint(width / 2 + tipOffset, 0);
-                    break;
-                case PE_IndicatorArrowDown:
-                    points[0] = QPoint(0, 0);
-                    points[1] = QPoint(width, 0);
-                    points[2] = QPoint(width / 2, height);
-                    points[3] = QPoint(width / 2 + tipOffset, height);
-                    break;
-                case PE_IndicatorArrowRight:
-                    points[0] = QPoint(0, 0);
-                    points[1] = QPoint(0, height);
-                    points[2] = QPoint(width, height / 2);
-                    points[3] = QPoint(width, height / 2 + tipOffset);
-                    break;
-                case PE_IndicatorArrowLeft:
-                    points[0] = QPoint(width, 0);
-                    points[1] = QPoint(width, height);
-                    points[2] = QPoint(0, height / 2);
-                    points[3] = QPoint(0, height / 2 + tipOffset);
-                    break;
-                default:
-                    break;
-            }
-            p->save();
-            p->setRenderHints(QPainter::Antialiasing);
-            p->setPen(Qt::NoPen);
-            p->setBrush(getBrush(opt->palette, Color::indicatorArrow, state));
-            p->translate(opt->rect.left() + (opt->rect.width() - width) / 2.0,
-                         opt->rect.top() + (opt->rect.height() - height) / 2.0);
-            p->drawPolygon(points, 3 + tipOffset);
-            p->restore();
+        case PE_IndicatorArrowRight:
+            drawIndicatorArrow(p, element, opt->rect, state, opt->palette, widget);
             return;
-        }
         case PE_Frame:
             if (const auto* frame = qstyleoption_cast<const QStyleOptionFrame*>(opt)) {
                 p->save();
@@ -2025,7 +1924,7 @@ void Style::drawPrimitive(QStyle::PrimitiveElement element, const QStyleOption*
                     p->fillRect(item->rect, (item->backgroundBrush.style() == Qt::NoBrush) ? getBrush(item->palette, Color::itemViewItemDefaultAlternateBg, state) : item->backgroundBrush);
                 }
                 // this is to paint a background behind the branch indicators
-                if (item->widget && item->widget->inherits("QTreeView") && item->state & (State_Selected)) {
+                if (widgetKinds(item->widget).testFlag(WidgetKind::TreeView) && item->state & (State_Selected)) {
                     state.pressed = item->state & State_Selected;
                     p->fillRect(item->rect, getColor(item->palette, Color::itemViewItemBg, state));
                 }
@@ -2037,12 +1936,12 @@ void Style::drawPrimitive(QStyle::PrimitiveElement element, const QStyleOption*
         case PE_PanelItemViewItem:
             if (const auto* item = qstyleoption_cast<const QStyleOptionViewItem*>(opt)) {
                 state.pressed = item->state & State_Selected;
-                const bool isListView = item->widget && item->widget->inherits("QListView");
+                const bool isListView = widgetKinds(item->widget).testFlag(WidgetKind::ListView);
                 const int cornerRadius = isListView ? config.listViewItemBorderRadius : 0;
 
                 QRect rect;
                 if (isListView) {
-                    if (item->widget && item->widget->inherits("KFilePlacesView")) {
+                    if (widgetKinds(item->widget).testFlag(WidgetKind::KFilePlacesView)) {
                         rect = item->rect.adjusted(config.kFilePlacesViewHorizontalMargin, 0, 0, -config.kFilePlacesViewHorizontalMargin);
                     } else if (item->decorationPosition == QStyleOptionViewItem::Top || item->decorationPosition == QStyleOptionViewItem::Bottom) {
                         rect = item->rect.adjusted(config.listViewItemVerticalMargin, config.listViewItemVerticalMargin, -config.listViewItemVerticalMargin, -config.listViewItemVerticalMargin);
@@ -2053,12 +1952,7 @@ void Style::drawPrimitive(QStyle::PrimitiveElement element, const QStyleOption*
                     rect = item->rect;
                 }
 
-                p->save();
-                p->setRenderHints(QPainter::Antialiasing);
-                p->setPen(Qt::NoPen);
-                p->setBrush(getBrush(item->palette, Color::itemViewItemBg, state));
-                p->drawRoundedRect(rect, cornerRadius, cornerRadius);
-                p->restore();
+                fillRoundedRect(p, rect, cornerRadius, getBrush(item->palette, Color::itemViewItemBg, state).color());
                 return;
             }
             break;
@@ -2081,6 +1975,10 @@ void Style::polish(QWidget* widget) {
 
     windowMgr.registerWidget(widget);
 
+    // classify once, so that painting does not have to call inherits()
+    widgetKindCache.insert(widget, classifyWidget(widget));
+    connect(widget, &QObject::destroyed, this, &Style::widgetDestroyed, Qt::UniqueConnection);
+
     if (widget->inherits("QAbstractButton") ||
         widget->inherits("QTabBar") ||
         widget->inherits("QScrollBar") ||
@@ -2093,26 +1991,10 @@ void Style::polish(QWidget* widget) {
     if (widget->inherits("QScrollBar")) {
         widget->setAttribute(Qt::WA_OpaquePaintEvent, false);
 
-    } else if (QMenu* menu = qobject_cast<QMenu*>(widget)) {
-        menu->setAttribute(Qt::WA_TranslucentBackground);
-
-    } else if (widget->inherits("QDockWidget") ||
-               widget->inherits("QTipLabel")) {
-        widget->setAttribute(Qt::WA_TranslucentBackground);
-
     } else if (widget->inherits("QComboBoxPrivateContainer")) {
         if (auto popup = qobject_cast<QFrame*>(widget)) {
             popup->setLineWidth(config.comboPopupPadding + config.comboPopupMargin);
-            popup->installEventFilter(this);
-            popup->setAttribute(Qt::WA_TranslucentBackground);
-
-            if (popup->graphicsEffect() == nullptr) {
-                QGraphicsDropShadowEffect* shadow = new QGraphicsDropShadowEffect(popup);
-                shadow->setOffset(0.3, 0.5);
-                shadow->setColor(getColor(popup->palette(), Color::comboBoxPopupShadow));
-                shadow->setBlurRadius(config.comboPopupShadowSize);
-                popup->setGraphicsEffect(shadow);
-            }
+            eventDispatcher.registerObject(popup, EventDispatcher::ComboPopup);
         }
 
     } else if (widget->parent() && widget->parent()->inherits("QComboBoxListView")) {
@@ -2133,16 +2015,25 @@ void Style::polish(QWidget* widget) {
         }
     }
 
+    if (TranslucencyManager::shouldManageWidget(widget)) {
+        translucencyMgr.registerWidget(widget);
+    }
 #if HAS_KWINDOWSYSTEM
     if (BlurManager::shouldBlurBehindWidget(widget)) {
         blurMgr.registerWidget(widget);
     }
+#endif
+#if HAS_X11
+    if (OpaqueRegionManager::shouldPublishForWidget(widget)) {
+        opaqueRegionMgr.registerWidget(widget);
+    }
 #endif
     SuperStyle::polish(widget);
 }
 
 void Style::unpolish(QWidget* widget) {
     windowMgr.unregisterWidget(widget);
+    tabMetricsCache.remove(widget);  // icon sizes may change with the icon theme
 
     if (widget->inherits("QAbstractButton") ||
         widget->inherits("QTabBar") ||
@@ -2156,111 +2047,46 @@ void Style::unpolish(QWidget* widget) {
     if (widget->inherits("QScrollBar")) {
         widget->setAttribute(Qt::WA_OpaquePaintEvent, true);
 
-    } else if (QMenu* menu = qobject_cast<QMenu*>(widget)) {
-        menu->setAttribute(Qt::WA_TranslucentBackground, false);
-
-    } else if (widget->inherits("QDockWidget") ||
-               widget->inherits("QTipLabel")) {
-        widget->setAttribute(Qt::WA_TranslucentBackground, false);
-
     } else if (widget->inherits("QComboBoxPrivateContainer")) {
         if (auto popup = qobject_cast<QFrame*>(widget)) {
             popup->setLineWidth(1);
-            popup->removeEventFilter(this);
-            popup->setAttribute(Qt::WA_TranslucentBackground, false);
-            popup->setGraphicsEffect(nullptr);
+            eventDispatcher.unregisterObject(popup, EventDispatcher::ComboPopup);
         }
     } else if (widget->parent() && widget->parent()->inherits("QComboBoxListView")) {
         widget->setAutoFillBackground(true);
     }
 
+    if (TranslucencyManager::shouldManageWidget(widget)) {
+        translucencyMgr.unregisterWidget(widget);
+    }
 #if HAS_KWINDOWSYSTEM
     if (BlurManager::shouldBlurBehindWidget(widget)) {
         blurMgr.unregisterWidget(widget);
     }
 #endif
+#if HAS_X11
+    if (OpaqueRegionManager::shouldPublishForWidget(widget)) {
+        opaqueRegionMgr.unregisterWidget(widget);
+    }
+#endif
 
     SuperStyle::unpolish(widget);
 }
 
 int Style::pixelMetric(QStyle::PixelMetric m, const QStyleOption* opt, const QWidget* widget) const {
+    int value;
+    if (pixelMetrics.find(m, &value)) {
+        return value;
+    }
+
     switch (m) {
-        case PM_ButtonShiftHorizontal:
-        case PM_ButtonShiftVertical:
-            return 0;
-        case PM_IndicatorHeight:
-        case PM_IndicatorWidth:
-        case PM_ExclusiveIndicatorWidth:
-        case PM_ExclusiveIndicatorHeight:
-            return config.checkBoxSize;
-        case PM_TabBarTabHSpace:  // unused in the impementation
-            return config.tabHorizontalPadding;
-        case PM_TabBarTabVSpace:  // vertical padding, for horizontal tabbar: top and bottom
-            return config.tabVerticalPadding;
-        case PM_TabBarTabShiftHorizontal:
-        case PM_TabBarTabShiftVertical:
-            return 0;
         case PM_TabBarBaseOverlap:
-            if (widget && widget->inherits("DolphinTabBar")) {
+            if (widgetKinds(widget).testFlag(WidgetKind::DolphinTabBar)) {
                 if (const auto tab = qstyleoption_cast<const QStyleOptionTab*>(opt)) {
                     return tabIsHorizontal(tab->shape) ? tab->rect.height() : tab->rect.width();
                 }
             }
             return 1;
-        case PM_TabCloseIndicatorWidth:
-        case PM_TabCloseIndicatorHeight:
-            return config.tabCloseIndicatorHoverSize;
-        case PM_SliderControlThickness:
-        case PM_SliderLength:
-            return config.sliderHandleDiameter;
-        case PM_SliderTickmarkOffset:
-            return config.sliderTickmarksOffset;
-        case PM_ScrollBarSliderMin:
-            return config.scrollbarSliderMinLen;
-        case PM_MenuHMargin:
-            return config.menuMargin;
-        case PM_MenuVMargin:
-            return config.menuVerticalPadding + config.menuMargin;
-        case PM_SubMenuOverlap:
-            return config.menuMargin * 2 - config.menuSubMenuSpacing;
-        case PM_MenuBarItemSpacing:
-            return 0;
-        case PM_MenuBarHMargin:
-        case PM_MenuBarVMargin:
-            return config.menuBarMargin;
-        case PM_MenuBarPanelWidth:
-            return 0;
-        case PM_ScrollView_ScrollBarOverlap:
-            return config.scrollBarThickness;
-        case PM_ToolBarFrameWidth:
-            return 0;
-        case PM_ToolBarItemMargin:
-            return config.toolBarPadding;
-        case PM_ToolBarItemSpacing:
-            return config.toolBarItemSpacing;
-        case PM_ToolBarSeparatorExtent:
-            return 3;
-        case PM_ToolBarHandleExtent:
-            return config.toolBarHandleHorizontalPadding * 2 + 2 + config.toolBarHandleLineSpacing;  // 2 is for the line thickness
-        case PM_ProgressBarChunkWidth:
-            return 2;
-        case PM_RadioButtonLabelSpacing:
-        case PM_CheckBoxLabelSpacing:  // implementtion uses Constants::checkBoxElementSpacing,
-            /* here i add 1/2 of the check width as a workaround for qqc2-desktop-theme styled apps,
-             * as they apparently count this distance from the center of the checkbox
-             */
-            return config.checkBoxElementSpacing + config.checkBoxSize / 2;
-        case PM_DockWidgetTitleMargin:
-            return config.dockHeaderLabelPadding;
-        case PM_DockWidgetFrameWidth:
-            return 0;
-        case PM_DockWidgetTitleBarButtonMargin:  // size of the dock header buttons
-            return config.dockHeaderControlsHoverPadding;
-        case PM_DockWidgetSeparatorExtent:
-        case PM_DockWidgetHandleExtent:
-            return 3;
-        case PM_ToolTipLabelFrameWidth:
-            return config.tooltipPadding;
 
         case PM_FocusFrameVMargin:
         case PM_FocusFrameHMargin: {
@@ -2299,54 +2125,42 @@ int Style::pixelMetric(QStyle::PixelMetric m, const QStyleOption* opt, const QWi
 }
 
 int Style::styleHint(QStyle::StyleHint hint, const QStyleOption* option, const QWidget* widget, QStyleHintReturn* returnData) const {
-    switch (hint) {
-        case SH_UnderlineShortcut:
-            return false;
-        case SH_MenuBar_MouseTracking:
-            return true;
-        case SH_Menu_Scrollable:
-            return true;
-        case SH_Menu_MouseTracking:
-            return true;
-        case SH_Menu_SubMenuPopupDelay:
-            return 150;
-        case SH_Menu_SloppySubMenus:
-            return true;
-        case SH_Menu_SupportsSections:
-            return true;
-        case SH_DrawMenuBarSeparator:
-            return false;
-        case SH_TabBar_Alignment:
-            return Qt::AlignLeft;
-        case SH_TabBar_PreferNoArrows:
-            return false;
-        case SH_ComboBox_Popup:
-            return false;
-        case SH_ComboBox_PopupFrameStyle:
-            return QFrame::StyledPanel;
-        case SH_ItemView_ShowDecorationSelected:
-            return true;
-        case SH_FocusFrame_AboveWidget:
-            return true;
-        case SH_FocusFrame_Mask:
-            return false;
-        case SH_Slider_AbsoluteSetButtons:
-            return true;
+    int value;
+    if (styleHints.find(hint, &value)) {
+        return value;
+    }
+    return SuperStyle::styleHint(hint, option, widget, returnData);
+}
 
-#if !HAS_KSTYLE
-        SH_Menu_SubMenuSloppyCloseTimeout:
-            return 300;
+void Style::updateMetrics() {
+    int oldOverlap = 0;
+    const bool hadMetrics = pixelMetrics.find(PM_ScrollView_ScrollBarOverlap, &oldOverlap);
 
-        case SH_ScrollBar_LeftClickAbsolutePosition:
-            return true;
+    // values which depend on the configuration, on top of the ones known at compile time
+    pixelMetrics = staticPixelMetrics;
+    const int overlap = config.scrollBarOverlay ? config.scrollBarOverlayThickness : config.scrollBarThickness;
+    pixelMetrics.set(PM_ScrollView_ScrollBarOverlap, overlap);
 
-        case SH_ToolButtonStyle:
-            return Qt::ToolButtonTextBesideIcon;
-#endif
-        default:
-            break;
+    styleHints = staticStyleHints;
+    styleHints.set(SH_ScrollBar_Transient, config.scrollBarOverlay);
+
+    if (!hadMetrics || !qobject_cast<QApplication*>(QCoreApplication::instance())) {
+        return;  // called from the constructor, no widget uses the style yet
+    }
+
+    // all widgets are laid out again only if a value which sizes them changed, the first settings are compared with the defaults
+    // the first widgets are laid out with, see Config, so most applications never do it,
+    // if only the scrollbar overlap or SH_ScrollBar_Transient changes only the scroll areas and scrollbars are,
+    // a scrollbar reads the latter only when it is created or gets a StyleChange
+    const bool layoutChanged = config.layoutChanged();
+    if (!layoutChanged && oldOverlap == overlap) {
+        return;
+    }
+    for (QWidget* widget : QApplication::allWidgets()) {
+        if (layoutChanged || qobject_cast<QAbstractScrollArea*>(widget) || qobject_cast<QScrollBar*>(widget)) {
+            QCoreApplication::postEvent(widget, new QEvent(QEvent::StyleChange));
+        }
     }
-    return SuperStyle::styleHint(hint, option, widget, returnData);
 }
 
 QRect Style::subElementRect(QStyle::SubElement element, const QStyleOption* opt, const QWidget* widget) const {
@@ -2436,13 +2250,15 @@ QRect Style::subElementRect(QStyle::SubElement element, const QStyleOption* opt,
                 const bool horizontal = tabIsHorizontal(tab->shape);
                 const bool centerText = config.tabContentAlignment == Config::IconStartTextCenter ||
                                         config.tabContentAlignment == Config::Center;
-                const QSize textSize = tab->fontMetrics.size((Qt::TextSingleLine | Qt::TextShowMnemonic), tab->text);
+                const TabMetrics metrics = tabBarTabMetrics(tab,
+                                                            (Qt::TextSingleLine | Qt::TextShowMnemonic),
+                                                            QSize(tab->iconSize.width(), qMin(tab->iconSize.height(), tab->rect.height())),
+                                                            widget);
+                const QSize textSize = metrics.textSize;
 
                 const QRect tabRect = horizontal ? tab->rect : QRect(0, 0, tab->rect.height(), tab->rect.width());
                 const int tabLen = tabRect.width();
-                const QSize iconSize = tab->icon.actualSize(QSize(tab->iconSize.width(),
-                                                                  qMin(tab->iconSize.height(), tab->rect.height())));
-                const int iconLen = iconSize.width();
+                const int iconLen = metrics.iconSize.width();
                 const int leftBtnLen = horizontal ? tab->leftButtonSize.width() : tab->leftButtonSize.height();
                 const int rightBtnLen = horizontal ? tab->rightButtonSize.width() : tab->rightButtonSize.height();
 
@@ -2590,7 +2406,7 @@ QRect Style::subElementRect(QStyle::SubElement element, const QStyleOption* opt,
                 }
 
                 QSize textSizeActual = bar->fontMetrics.size((Qt::TextSingleLine | Qt::TextShowMnemonic), bar->text);
-                QSize textSizeDefault = bar->fontMetrics.size((Qt::TextSingleLine | Qt::TextShowMnemonic), "100%");
+                QSize textSizeDefault = progressBarDefaultLabelSize(bar, widget);
                 QSize& textSize = textSizeDefault.width() > textSizeActual.width() ? textSizeDefault : textSizeActual;
 
                 if (!horizontal) {
@@ -2652,7 +2468,7 @@ QRect Style::subElementRect(QStyle::SubElement element, const QStyleOption* opt,
 
         case SE_ItemViewItemCheckIndicator:
             if (const auto* item = qstyleoption_cast<const QStyleOptionViewItem*>(opt)) {
-                const bool isListView = item->widget && item->widget->inherits("QListView");
+                const bool isListView = widgetKinds(item->widget).testFlag(WidgetKind::ListView);
 
                 QRect rect(QPoint(0, 0), QSize(config.checkBoxSize, config.checkBoxSize));
                 rect.moveCenter(item->rect.center());
@@ -2665,10 +2481,10 @@ QRect Style::subElementRect(QStyle::SubElement element, const QStyleOption* opt,
 
         case SE_ItemViewItemDecoration:
             if (const auto* item = qstyleoption_cast<const QStyleOptionViewItem*>(opt)) {
-                const bool isListView = item->widget && item->widget->inherits("QListView");
+                const bool isListView = widgetKinds(item->widget).testFlag(WidgetKind::ListView);
 
                 // this is a workaround for an issue in kate, where the text in top bread crumbs was cut away
-                const bool isBreadCrumbView = item->widget && item->widget->inherits("BreadCrumbView");
+                const bool isBreadCrumbView = widgetKinds(item->widget).testFlag(WidgetKind::BreadCrumbView);
 
                 const int checkBoxWidth = (item->features & QStyleOptionViewItem::HasCheckIndicator) ?
                                               config.checkBoxSize + config.itemViewItemElementSpacing :
@@ -2702,7 +2518,7 @@ QRect Style::subElementRect(QStyle::SubElement element, const QStyleOption* opt,
 
         case SE_ItemViewItemText:
             if (const auto* item = qstyleoption_cast<const QStyleOptionViewItem*>(opt)) {
-                const bool isListView = item->widget && item->widget->inherits("QListView");
+                const bool isListView = widgetKinds(item->widget).testFlag(WidgetKind::ListView);
                 const bool hasDecoration = item->features & QStyleOptionViewItem::HasDecoration && !item->icon.isNull();
                 const bool verticalLayout = item->decorationPosition == QStyleOptionViewItem::Top || item->decorationPosition == QStyleOptionViewItem::Bottom;
 
@@ -2711,7 +2527,7 @@ QRect Style::subElementRect(QStyle::SubElement element, const QStyleOption* opt,
                 int itemViewItemHorizontalPadding = config.itemViewItemHorizontalPadding;
 
                 // this is a workaround for an issue in kate, where the text in top bread crumbs was cut away
-                if (item->widget && item->widget->inherits("BreadCrumbView")) {
+                if (widgetKinds(item->widget).testFlag(WidgetKind::BreadCrumbView)) {
                     listViewItemHorizontalMargin = 0;
                     elementSpacing = 0;
                     itemViewItemHorizontalPadding = 0;
@@ -3284,10 +3100,11 @@ QSize Style::sizeFromContents(QStyle::ContentsType ct, const QStyleOption* opt,
             break;
         case CT_ScrollBar:
             if (const auto* bar = qstyleoption_cast<const QStyleOptionSlider*>(opt)) {
+                const int thickness = config.scrollBarOverlay ? config.scrollBarOverlayThickness : config.scrollBarThickness;
                 if (bar->orientation == Qt::Horizontal) {
-                    return QSize(1, config.scrollBarThickness);
+                    return QSize(1, thickness);
                 }
-                return QSize(config.scrollBarThickness, 1);
+                return QSize(thickness, 1);
             }
             break;
 
@@ -3315,7 +3132,7 @@ QSize Style::sizeFromContents(QStyle::ContentsType ct, const QStyleOption* opt,
 
         case CT_ToolButton:
             if (const auto* btn = qstyleoption_cast<const QStyleOptionToolButton*>(opt)) {
-                if (btn->iconSize.isValid() && widget && widget->inherits("KMultiTabBarTab")) {
+                if (btn->iconSize.isValid() && widgetKinds(widget).testFlag(WidgetKind::KMultiTabBarTab)) {
                     return btn->iconSize + QSize(config.toolBtnLabelHorizontalPadding * 2, config.toolBtnLabelVerticalPadding * 2);
                 }
 
@@ -3396,14 +3213,9 @@ QSize Style::sizeFromContents(QStyle::ContentsType ct, const QStyleOption* opt,
 
         case CT_TabBarTab:
             if (const auto* tab = qstyleoption_cast<const QStyleOptionTab*>(opt)) {
-                QSize textSize;
-                if (!tab->text.isEmpty()) {
-                    textSize = tab->fontMetrics.size(Qt::TextShowMnemonic, tab->text);
-                }
-                QSize iconSize;
-                if (!tab->icon.isNull() && tab->iconSize.isValid()) {
-                    iconSize = tab->icon.actualSize(tab->iconSize);
-                }
+                const TabMetrics metrics = tabBarTabMetrics(tab, Qt::TextShowMnemonic, tab->iconSize, widget);
+                const QSize textSize = metrics.textSize;
+                const QSize iconSize = metrics.iconSize;
 
                 if (tabIsHorizontal(tab->shape)) {
                     int elements = 0;
@@ -3488,7 +3300,7 @@ QSize Style::sizeFromContents(QStyle::ContentsType ct, const QStyleOption* opt,
 
         case CT_ItemViewItem:
             if (const auto* item = qstyleoption_cast<const QStyleOptionViewItem*>(opt)) {
-                const bool isListView = item->widget && item->widget->inherits("QListView");
+                const bool isListView = widgetKinds(item->widget).testFlag(WidgetKind::ListView);
                 const QSize textSize = item->text.isEmpty() ? QSize() : QFontMetrics(item->font).size(Qt::TextShowMnemonic, item->text);
                 const QSize iconSize = (item->features & QStyleOptionViewItem::HasDecoration && !item->icon.isNull()) ? item->decorationSize : QSize();
 
@@ -3572,6 +3384,31 @@ QSize Style::sizeFromContents(QStyle::ContentsType ct, const QStyleOption* opt,
     return SuperStyle::sizeFromContents(ct, opt, contentsSize, widget);
 }
 
+QPixmap Style::generatedIconPixmap(QIcon::Mode iconMode, const QPixmap& pixmap, const QStyleOption* opt) const {
+    if ((iconMode != QIcon::Disabled && iconMode != QIcon::Selected) || pixmap.isNull()) {
+        return SuperStyle::generatedIconPixmap(iconMode, pixmap, opt);
+    }
+
+    const QRgb highlight = (opt ? opt->palette : QGuiApplication::palette()).color(QPalette::Normal, QPalette::Highlight).rgba();
+    // the cache key of a pixmap changes whenever its contents do
+    const PixmapCache::Key key = PixmapCache::key(PixmapCache::GeneratedIcon, pixmap.cacheKey(), int(iconMode), iconMode == QIcon::Selected ? highlight : 0);
+    QPixmap generated;
+    if (pixmapCache.find(key, pixmap.devicePixelRatio(), &generated)) {
+        return generated;
+    }
+
+    QImage image = pixmap.toImage().convertToFormat(QImage::Format_ARGB32_Premultiplied);
+    if (iconMode == QIcon::Disabled) {
+        desaturateImage(&image, config.iconDisabledOpacity);
+    } else {
+        tintImage(&image, highlight, config.iconSelectedTintStrength);
+    }
+    generated = QPixmap::fromImage(image);
+    generated.setDevicePixelRatio(pixmap.devicePixelRatio());
+    pixmapCache.insert(key, pixmap.devicePixelRatio(), generated);
+    return generated;
+}
+
 bool Style::eventFilter(QObject* object, QEvent* event) {
     QWidget* widget = qobject_cast<QWidget*>(object);
     if (!widget) {
@@ -3590,6 +3427,10 @@ bool Style::eventFilter(QObject* object, QEvent* event) {
                                                        -config.comboPopupMargin);
         QPainter p(widget);
         p.setClipRegion(paintEvent->region());
+        if (!TranslucencyManager::hasAlphaChannel(widget)) {
+            p.fillRect(paintEvent->rect(), opt.palette.window());  // without a compositor the margin would be black
+        }
+        drawRoundedRectShadow(&p, &pixmapCache, rect, config.menuBorderRadius, config.comboPopupShadowSize, config.comboPopupShadowOffset, getColor(opt.palette, Color::comboBoxPopupShadow));
         p.setRenderHint(QPainter::Antialiasing);
         p.setPen(getPen(opt.palette, Color::line, 1));
         p.setBrush(getBrush(opt.palette, Color::comboBoxPopupBg));
@@ -3625,6 +3466,233 @@ Style::MenuItemText Style::menuItemGetText(const QStyleOptionMenuItem* menu) {
     return text;
 }
 
+QPainterPath Style::tabShapePath(QRectF rect, const QTabBar::Shape shape, const bool isSelected) const {
+    const int cornerRadius = config.tabCornerRadius;
+    qreal cornerRectSize;
+    switch (shape) {
+        case QTabBar::RoundedNorth:
+        case QTabBar::TriangularNorth:
+        case QTabBar::RoundedSouth:
+        case QTabBar::TriangularSouth:
+            cornerRectSize = qMin(cornerRadius * 2.0,  // the corner radius is still cornerRadius,
+                                  qMin(rect.width(),   // it has to be *2 because this reqires the diameter
+                                       rect.height() * 2));
+
+            break;
+
+        case QTabBar::RoundedEast:
+        case QTabBar::TriangularEast:
+        case QTabBar::RoundedWest:
+        case QTabBar::TriangularWest:
+            cornerRectSize = qMin(cornerRadius * 2.0,
+                                  qMin(rect.height(),
+                                       rect.width() * 2));
+            break;
+    };
+
+    QPainterPath path;
+    switch (shape) {
+        case QTabBar::RoundedNorth:
+        case QTabBar::TriangularNorth:
+            rect.adjust(0.5, 0.5, -0.5, isSelected ? 0 : -1.5);
+
+            path.moveTo(rect.bottomLeft());
+            path.lineTo(rect.left(), rect.top() + cornerRadius);
+            path.arcTo(QRectF(
+                           rect.topLeft(),
+                           QPointF(rect.left() + cornerRectSize, rect.top() + cornerRectSize)),
+                       180,
+                       -90);
+            path.lineTo(rect.right() - cornerRadius, rect.top());
+            path.arcTo(QRectF(
+                           rect.topRight(),
+                           QPointF(rect.right() - cornerRectSize, rect.top() + cornerRectSize)),
+                       90,
+                       90);
+            path.lineTo(rect.bottomRight());
+            break;
+
+        case QTabBar::RoundedSouth:
+        case QTabBar::TriangularSouth:
+            rect.adjust(0.5, isSelected ? 0 : 1.5, -0.5, -0.5);
+
+            path.moveTo(rect.topLeft());
+            path.lineTo(rect.left(), rect.bottom() - cornerRadius);
+            path.arcTo(QRectF(
+                           rect.bottomLeft(),
+                           QPointF(rect.left() + cornerRectSize, rect.bottom() - cornerRectSize)),
+                       180,
+                       -90);
+            path.lineTo(rect.right() - cornerRadius, rect.bottom());
+            path.arcTo(QRectF(
+                           rect.bottomRight(),
+                           QPointF(rect.right() - cornerRectSize, rect.bottom() - cornerRectSize)),
+                       90,
+                       90);
+            path.lineTo(rect.topRight());
+            break;
+
+        case QTabBar::RoundedWest:
+        case QTabBar::TriangularWest:
+            rect.adjust(0.5, 0.5, isSelected ? 0 : -1.5, -0.5);
+
+            path.moveTo(rect.topRight());
+            path.lineTo(rect.left() + cornerRadius, rect.top());
+            path.arcTo(QRectF(
+                           rect.topLeft(),
+                           QPointF(rect.left() + cornerRectSize, rect.top() + cornerRectSize)),
+                       90,
+                       90);
+            path.lineTo(rect.left(), rect.bottom() - cornerRadius);
+            path.arcTo(QRectF(
+                           rect.bottomLeft(),
+                           QPointF(rect.left() + cornerRectSize, rect.bottom() - cornerRectSize)),
+                       180,
+                       -90);
+            path.lineTo(rect.bottomRight());
+            break;
+
+        case QTabBar::RoundedEast:
+        case QTabBar::TriangularEast:
+            rect.adjust(isSelected ? 0 : 1.5, 0.5, -0.5, -0.5);
+
+            path.moveTo(rect.topLeft());
+            path.lineTo(rect.right() - cornerRadius, rect.top());
+            path.arcTo(QRectF(
+                           rect.topRight(),
+                           QPointF(rect.right() - cornerRectSize, rect.top() + cornerRectSize)),
+                       90,
+                       90);
+            path.lineTo(rect.right(), rect.bottom() - cornerRadius);
+            path.arcTo(QRectF(
+                           rect.bottomRight(),
+                           QPointF(rect.right() - cornerRectSize, rect.bottom() - cornerRectSize)),
+                       180,
+                       -90);
+            path.lineTo(rect.bottomLeft());
+            break;
+    }
+    return path;
+}
+
+qreal Style::scrollBarOverlayOpacity(const QStyleOptionSlider* bar, const QWidget* widget) const {
+    // QScrollBar sets State_On while its scroll area flashes it, which happens on every scroll
+    const bool active = bar->state & (QStyle::State_On | QStyle::State_Sunken | QStyle::State_MouseOver);
+    if (!widget) {
+        return 1;
+    }
+
+    auto it = scrollBarOverlayStates.find(widget);
+    if (it == scrollBarOverlayStates.end()) {
+        it = scrollBarOverlayStates.insert(widget, ScrollBarOverlayState());
+        connect(widget, &QObject::destroyed, this, [this, widget]() { scrollBarOverlayStates.remove(widget); });
+    }
+
+    if (active) {
+        it->hold.setRemainingTime(config.scrollBarOverlayHoldDuration);
+    } else if (!it->hold.hasExpired() && !it->repaintPending) {
+        // nothing else repaints the scrollbar once the scrolling stops, so do it when the hold is over to start fading out
+        it->repaintPending = true;
+        QTimer::singleShot(static_cast<int>(it->hold.remainingTime()), widget, [this, widget]() {
+            auto state = scrollBarOverlayStates.find(widget);
+            if (state != scrollBarOverlayStates.end()) {
+                state->repaintPending = false;
+            }
+            const_cast<QWidget*>(widget)->update();
+        });
+    }
+
+    const bool visible = active || !it->hold.hasExpired();
+    return animationMgr.getCurrentValue<qreal>(widget, 0, 1, config.scrollBarOverlayFadeDuration, visible ? QVariantAnimation::Forward : QVariantAnimation::Backward);
+}
+
+void Style::drawScrollBarSlider(QPainter* p, const QRect& rect, const bool horizontal, const Lilac::State& state, const QPalette& palette, const QWidget* widget) const {
+    const int defaultThickness = horizontal ? rect.height() : rect.width();
+
+    const int normalThickness = defaultThickness - 2 * config.scrollBarSliderPadding;
+    const int hoverThickness = defaultThickness - 2 * config.scrollBarSliderPaddingHover;
+    const qreal animationProgress = animationMgr.getOnlyValue<qreal>(widget, state.enabled && state.hovered ? 1 : 0);
+
+    QRect originalRect;
+    QRectF sliderRect;
+    if (horizontal) {
+        originalRect = rect.adjusted(0, 1, 0, 0);  // the +1 is for the separator line above the hovered separator width
+        sliderRect = originalRect;
+        sliderRect.setHeight((hoverThickness - normalThickness) * animationProgress + normalThickness);
+    } else {
+        originalRect = rect.adjusted(1, 0, 0, 0);
+        sliderRect = originalRect;
+        sliderRect.setWidth((hoverThickness - normalThickness) * animationProgress + normalThickness);
+    }
+    sliderRect.moveCenter(originalRect.center());
+    const double cornerRadius = horizontal ? sliderRect.height() / 2.0 : sliderRect.width() / 2.0;
+    fillRoundedRect(p, sliderRect, cornerRadius, getBrush(palette, Color::scrollBarSlider, state).color());
+}
+
+void Style::drawIndicatorArrow(QPainter* p, const QStyle::PrimitiveElement arrow, const QRect& rect, const Lilac::State& state, const QPalette& palette, const QWidget* widget) const {
+    int size = qMin(rect.width(), rect.height());
+    // size of the top naviagtion arrows in dolphin
+    if (widgetKinds(widget).testFlag(WidgetKind::KUrlNavigatorButtonBase)) {
+        size = qMin(config.dolphinUrlNavigatorArrowSize, size);
+    }
+    const int tipOffset = size % 2;
+    /* tipOffset: is so for odd size rect the arrow is is still symetrical
+     * e.g for the down arrow:
+     * if the width of the rect is odd the tip's x would not be a whole number,
+     * so instead of a recangle I draw a trapezoid with the tip being 2px long
+     * because trapezoid has 4 sides, in p->drawPolygon I do 4 if trapezoid and 3
+     * if triangle.
+     */
+
+    int width = 0;
+    int height = 0;
+    if (arrow == PE_IndicatorArrowUp || arrow == PE_IndicatorArrowDown) {
+        width = size;
+        height = size / 2;
+    } else {
+        height = size;
+        width = size / 2;
+    }
+
+    QPoint points[4];
+    switch (arrow) {
+        case PE_IndicatorArrowUp:
+            points[0] = QPoint(0, height);
+            points[1] = QPoint(width, height);
+            points[2] = QPoint(width / 2, 0);
+            points[3] = QPoint(width / 2 + tipOffset, 0);
+            break;
+        case PE_IndicatorArrowDown:
+            points[0] = QPoint(0, 0);
+            points[1] = QPoint(width, 0);
+            points[2] = QPoint(width / 2, height);
+            points[3] = QPoint(width / 2 + tipOffset, height);
+            break;
+        case PE_IndicatorArrowRight:
+            points[0] = QPoint(0, 0);
+            points[1] = QPoint(0, height);
+            points[2] = QPoint(width, height / 2);
+            points[3] = QPoint(width, height / 2 + tipOffset);
+            break;
+        case PE_IndicatorArrowLeft:
+            points[0] = QPoint(width, 0);
+            points[1] = QPoint(width, height);
+            points[2] = QPoint(0, height / 2);
+            points[3] = QPoint(0, height / 2 + tipOffset);
+            break;
+        default:
+            break;
+    }
+    p->save();
+    p->setRenderHints(QPainter::Antialiasing);
+    p->setPen(Qt::NoPen);
+    p->setBrush(getBrush(palette, Color::indicatorArrow, state));
+    p->translate(rect.left() + (rect.width() - width) / 2.0,
+                 rect.top() + (rect.height() - height) / 2.0);
+    p->drawPolygon(points, 3 + tipOffset);
+    p->restore();
+}
+
 int Style::scrollbarGetSliderLength(const QStyleOptionSlider* bar) const {
     const int barLen = bar->orientation == Qt::Horizontal ? bar->rect.width() : bar->rect.height();
     const int contentLen = bar->maximum - bar->minimum + bar->pageStep;
@@ -3641,6 +3709,58 @@ int Style::getTextFlags(const QStyleOption* opt) const {
     return textFlags;
 }
 
+void Style::drawLabelText(QPainter* p, const QRect& rect, const int flags, const QString& text) const {
+    // multiple lines and right to left layouts are rare in these labels, they are left to drawText()
+    if (text.contains(QLatin1Char('\n')) || p->layoutDirection() == Qt::RightToLeft) {
+        p->drawText(rect, flags, text);
+        return;
+    }
+
+    const bool showMnemonic = (flags & Qt::TextShowMnemonic) && !(flags & Qt::TextHideMnemonic);
+    const LabelTextKey key{text, p->font(), showMnemonic};
+    QStaticText* staticText = labelTexts.object(key);
+    if (!staticText) {
+        // QStaticText knows no mnemonics, the markers are removed here and the mnemonic is underlined with rich text
+        QString plain;
+        int mnemonic = -1;
+        plain.reserve(text.size());
+        for (qsizetype i = 0; i < text.size(); i++) {
+            if (text[i] == QLatin1Char('&')) {
+                i++;
+                if (i == text.size()) {
+                    break;
+                }
+                if (text[i] != QLatin1Char('&') && mnemonic < 0) {
+                    mnemonic = plain.size();
+                }
+            }
+            plain.append(text[i]);
+        }
+
+        staticText = new QStaticText();
+        if (showMnemonic && mnemonic >= 0) {
+            staticText->setTextFormat(Qt::RichText);
+            staticText->setText(QStringLiteral("<span style=\"white-space:pre\">%1<u>%2</u>%3</span>")
+                                    .arg(plain.left(mnemonic).toHtmlEscaped(),
+                                         plain.mid(mnemonic, 1).toHtmlEscaped(),
+                                         plain.mid(mnemonic + 1).toHtmlEscaped()));
+        } else {
+            staticText->setTextFormat(Qt::PlainText);
+            staticText->setText(plain);
+        }
+        staticText->setPerformanceHint(QStaticText::AggressiveCaching);
+        staticText->prepare(p->transform(), key.font);
+        labelTexts.insert(key, staticText);
+    }
+
+    const QSize size(qCeil(staticText->size().width()), qCeil(staticText->size().height()));
+    if (size.width() > rect.width() || size.height() > rect.height()) {
+        p->drawText(rect, flags, text);  // clipped by drawText()
+        return;
+    }
+    p->drawStaticText(QStyle::alignedRect(p->layoutDirection(), Qt::Alignment(flags & Qt::AlignmentMask), size, rect).topLeft(), *staticText);
+}
+
 QRect Style::tabBarGetTabRect(const QStyleOptionTab* tab) const {
     const int startMargin = (tab->position == QStyleOptionTab::Beginning || tab->position == QStyleOptionTab::OnlyOneTab) ?
                                 config.tabBarStartMargin :
@@ -3684,7 +3804,7 @@ bool Style::tabIsHorizontal(const QTabBar::Shape& tabShape) {
     return true;
 }
 
-QRect Style::tabBarTabIconRect(const QStyleOptionTab* tab, const Lilac::State& state, const QRect& textRect) const {
+QRect Style::tabBarTabIconRect(const QStyleOptionTab* tab, const Lilac::State& state, const QRect& textRect, const QWidget* widget) const {
     if (tab->icon.isNull() || !tab->iconSize.isValid()) {
         return QRect();
     }
@@ -3699,8 +3819,11 @@ QRect Style::tabBarTabIconRect(const QStyleOptionTab* tab, const Lilac::State& s
     const int rightBtnLen = horizontal ? tab->rightButtonSize.width() : tab->rightButtonSize.height();
 
     QRect iconRect;
-    iconRect.setSize(tab->icon.actualSize(QSize(tab->iconSize.width(),
-                                                qMin(tab->iconSize.height(), tab->rect.height()))));
+    iconRect.setSize(tabBarTabMetrics(tab,
+                                      (Qt::TextSingleLine | Qt::TextShowMnemonic),
+                                      QSize(tab->iconSize.width(), qMin(tab->iconSize.height(), tab->rect.height())),
+                                      widget)
+                         .iconSize);
 
     iconRect.moveCenter(tabRect.center());
 
@@ -3728,129 +3851,310 @@ QRect Style::tabBarTabIconRect(const QStyleOptionTab* tab, const Lilac::State& s
     return iconRect;
 }
 
-void Style::drawDropShadow(QPainter* p, const QRectF& rect, const qreal cornerRadius, const qreal blurRadius, const QPointF offset, const QColor color) {
-    if (rect.isNull() || blurRadius <= 0) {
+QSize Style::progressBarDefaultLabelSize(const QStyleOptionProgressBar* bar, const QWidget* widget) const {
+    const auto measure = [](const QFontMetrics& fontMetrics) { return fontMetrics.size((Qt::TextSingleLine | Qt::TextShowMnemonic), "100%"); };
+
+    // the option only has the font metrics, the font is known only with a widget
+    if (!widget) {
+        return measure(bar->fontMetrics);
+    }
+
+    // measured like QWidget::fontMetrics(), which depends on the dpi of the widget's screen as well
+    const std::pair<QFont, int> key(widget->font(), widget->logicalDpiY());
+    const auto it = progressBarLabelSizes.constFind(key);
+    if (it != progressBarLabelSizes.constEnd()) {
+        return *it;
+    }
+
+    constexpr int maxEntries = 16;
+    if (progressBarLabelSizes.size() >= maxEntries) {
+        progressBarLabelSizes.clear();
+    }
+    const QSize size = measure(QFontMetrics(key.first, widget));
+    progressBarLabelSizes.insert(key, size);
+    return size;
+}
+
+Style::TabMetrics Style::tabBarTabMetrics(const QStyleOptionTab* tab, const int textFlags, const QSize& iconSize, const QWidget* widget) const {
+    const auto measure = [&](const QFontMetrics& fontMetrics) {
+        TabMetrics metrics;
+        if (!tab->text.isEmpty()) {
+            metrics.textSize = fontMetrics.size(textFlags, tab->text);
+        }
+        if (!tab->icon.isNull() && iconSize.isValid()) {
+            metrics.iconSize = tab->icon.actualSize(iconSize);
+        }
+        return metrics;
+    };
+
+    // the cache of a tab bar is removed in widgetDestroyed(), which is connected only for polished widgets
+    if (!widget || !widgetKindCache.contains(widget)) {
+        return measure(tab->fontMetrics);
+    }
+
+    // measured like QWidget::fontMetrics(), which depends on the dpi of the widget's screen as well
+    const TabMetricsKey key{tab->text,
+                            widget->font(),
+                            widget->logicalDpiY(),
+                            tab->icon.cacheKey(),
+                            iconSize,
+                            textFlags,
+                            tab->shape,
+                            int(config.tabContentAlignment)};
+
+    QHash<TabMetricsKey, TabMetrics>& tabBarCache = tabMetricsCache[widget];
+    const auto it = tabBarCache.constFind(key);
+    if (it != tabBarCache.constEnd()) {
+        return *it;
+    }
+
+    // entries of renamed and closed tabs are never looked up again
+    constexpr int maxEntries = 256;
+    if (tabBarCache.size() >= maxEntries) {
+        tabBarCache.clear();
+    }
+    const TabMetrics metrics = measure(QFontMetrics(key.font, widget));
+    tabBarCache.insert(key, metrics);
+    return metrics;
+}
+
+Style::CheckIndicator Style::checkIndicator(const bool radio, const QStyle::State styleState, const QPalette& palette) const {
+    const Lilac::State state(styleState);
+
+    CheckIndicator indicator;
+    indicator.radio = radio;
+    indicator.checkState = styleState & QStyle::State_Off ? QStyle::State_Off : (styleState & QStyle::State_NoChange ? QStyle::State_NoChange : QStyle::State_On);
+    indicator.hoverCircle = state.hovered && state.enabled;
+    indicator.cornerRadius = (!radio && !config.circleCheckBox) ? config.checkBoxCornerRadius : -1;
+    if (indicator.hoverCircle) {
+        indicator.hoverCircleColor = getColor(palette, (styleState & State_Off) ? Color::checkBoxHoverCircle : Color::checkBoxHoverCircleChecked, state);
+    }
+    if (indicator.checkState == QStyle::State_Off) {
+        indicator.outlineColor = getColor(palette, Color::checkBoxOutline, state);
+    } else {
+        indicator.insideColor = getColor(palette, Color::checkBoxInside, state);
+        indicator.checkColor = getColor(palette, Color::checkBoxCheck, state);
+    }
+    return indicator;
+}
+
+PixmapCache::Key Style::checkIndicatorKey(const QSize& size, const quint32 phaseKey, const CheckIndicator& indicator) {
+    return PixmapCache::key(PixmapCache::CheckIndicator,
+                            phaseKey,
+                            size.width(),
+                            size.height(),
+                            int(indicator.radio),
+                            int(indicator.checkState),
+                            int(indicator.hoverCircle),
+                            indicator.cornerRadius,
+                            indicator.hoverCircleColor.rgba(),
+                            indicator.outlineColor.rgba(),
+                            indicator.insideColor.rgba(),
+                            indicator.checkColor.rgba());
+}
+
+void Style::drawCheckIndicator(QPainter* p, const QRect& rect, const CheckIndicator& indicator) const {
+    if (!PixmapCache::canBlit(p) || rect.isEmpty()) {
+        renderCheckIndicator(p, rect, indicator);
+        return;
+    }
+
+    const qreal dpr = p->device()->devicePixelRatioF();
+    const PixmapCache::Placement placement = PixmapCache::placement(p, rect.topLeft());
+    const PixmapCache::Key key = checkIndicatorKey(rect.size(), placement.phaseKey, indicator);
+    QPixmap pixmap;
+    if (!pixmapCache.find(key, dpr, &pixmap)) {
+        pixmap = QPixmap::fromImage(PixmapCache::render(rect.size(), dpr, placement.phase, [&](QPainter* painter) {
+            renderCheckIndicator(painter, QRect(QPoint(0, 0), rect.size()), indicator);
+        }));
+        pixmapCache.insert(key, dpr, pixmap);
+    }
+    p->drawPixmap(placement.position, pixmap);
+}
+
+void Style::renderCheckIndicator(QPainter* p, const QRect& rect, const CheckIndicator& indicator) {
+    const int indicatorSize = qMin(Config::checkBoxSize, qMin(rect.height() - 1, rect.width()) - 1);
+
+    QRect indicatorRect = QRect(0, 0, indicatorSize, indicatorSize);
+    indicatorRect.moveCenter(rect.center());
+
+    // the shapes are drawn directly into the image when this renders into the cache
+    if (indicator.hoverCircle) {
+        const int size = qMin(Config::checkBoxHoverCircleSize, qMin(rect.height(), rect.width()));
+        QRect hoverRect(0, 0, size, size);
+        hoverRect.moveCenter(rect.center());
+        fillEllipse(p, hoverRect, indicator.hoverCircleColor);
+    }
+
+    if (indicator.checkState == QStyle::State_Off) {
+        if (indicator.cornerRadius >= 0) {
+            strokeRoundedRect(p, indicatorRect, indicator.cornerRadius, 2, indicator.outlineColor);
+        } else {
+            strokeEllipse(p, indicatorRect, 2, indicator.outlineColor);
+        }
+        return;
+    }
+
+    if (indicator.cornerRadius >= 0) {
+        fillRoundedRect(p, indicatorRect, indicator.cornerRadius, indicator.insideColor);
+    } else {
+        fillEllipse(p, indicatorRect, indicator.insideColor);
+    }
+
+    if (indicator.radio) {
+        const double adjustment = indicatorSize * 0.35;
+        fillEllipse(p, indicatorRect.toRectF().adjusted(adjustment, adjustment, -adjustment, -adjustment), indicator.checkColor);
         return;
     }
 
     p->save();
-    p->setRenderHint(QPainter::Antialiasing);
-
-    QPainterPath clipPath(rect.topLeft() + QPoint(cornerRadius, 0));
-    // +1 because othervise there may be holes between the widget and the shadow
-    QRectF clipRect(0, 0, (cornerRadius * 2) + 1, (cornerRadius * 2) + 1);
-
-    clipRect.moveTopRight(rect.topRight());
-    clipPath.arcTo(clipRect, 90, -90);
-
-    clipRect.moveBottomRight(rect.bottomRight());
-    clipPath.arcTo(clipRect, 0, -90);
-
-    clipRect.moveBottomLeft(rect.bottomLeft());
-    clipPath.arcTo(clipRect, 270, -90);
-
-    clipRect.moveTopLeft(rect.topLeft());
-    clipPath.arcTo(clipRect, 180, -90);
-
-    // +- 2 because the rect needs to include all of the blur, so 2 is added just to make sure that nothing is cropped off
-    QRectF clipRectOutside = rect.adjusted(-blurRadius - 2, -blurRadius - 2, blurRadius + 2, blurRadius + 2);
-
-    clipPath.lineTo(clipRectOutside.topLeft());
-    clipPath.lineTo(clipRectOutside.bottomLeft());
-    clipPath.lineTo(clipRectOutside.bottomRight());
-    clipPath.lineTo(clipRectOutside.topRight());
-    clipPath.lineTo(clipRectOutside.topLeft());
-    clipPath.closeSubpath();
-
-    p->setClipPath(clipPath);
-    p->translate(offset);
-
-    // sides
-    QLinearGradient sideGradient;
-    sideGradient.setColorAt(0, color);
-    // The color transition's 2/3 point is being linked to the size's 1/3 point to more accurately imitate blur
-    sideGradient.setColorAt(0.33, QColor(color.red(), color.green(), color.blue(), color.alpha() / 3));
-    sideGradient.setColorAt(1, Qt::transparent);
-    QRectF drawingRect;
-
-    // top
-    drawingRect = QRectF(QPointF(rect.left() + cornerRadius, rect.top() - blurRadius),
-                         QPointF(rect.right() - cornerRadius, rect.top()));
-    sideGradient.setStart(drawingRect.bottomLeft());
-    sideGradient.setFinalStop(drawingRect.topLeft());
-    p->fillRect(drawingRect, QBrush(sideGradient));
-
-    // bottom
-    drawingRect = QRectF(QPointF(rect.left() + cornerRadius, rect.bottom()),
-                         QPointF(rect.right() - cornerRadius, rect.bottom() + blurRadius));
-    sideGradient.setStart(drawingRect.topLeft());
-    sideGradient.setFinalStop(drawingRect.bottomLeft());
-    p->fillRect(drawingRect, QBrush(sideGradient));
-
-    // left
-    drawingRect = QRectF(QPointF(rect.left() - blurRadius, rect.top() + cornerRadius),
-                         QPointF(rect.left(), rect.bottom() - cornerRadius));
-    sideGradient.setStart(drawingRect.topRight());
-    sideGradient.setFinalStop(drawingRect.topLeft());
-    p->fillRect(drawingRect, QBrush(sideGradient));
-
-    // right
-    drawingRect = QRectF(QPointF(rect.right(), rect.top() + cornerRadius),
-                         QPointF(rect.right() + blurRadius, rect.bottom() - cornerRadius));
-    sideGradient.setStart(drawingRect.topLeft());
-    sideGradient.setFinalStop(drawingRect.topRight());
-    p->fillRect(drawingRect, QBrush(sideGradient));
-
-    // corners
-    QRadialGradient cornerGradient;
-    const qreal startPosition = cornerRadius / (cornerRadius + blurRadius);
-    cornerGradient.setColorAt(0, color);
-    cornerGradient.setColorAt(startPosition, color);
-    cornerGradient.setColorAt(startPosition + 0.33 * (1 - startPosition), QColor(color.red(), color.green(), color.blue(), color.alpha() / 3));
-    cornerGradient.setColorAt(1, Qt::transparent);
-    cornerGradient.setRadius(blurRadius + cornerRadius);
-
-    // top left
-    drawingRect.setTopLeft(rect.topLeft() + QPointF(-blurRadius, -blurRadius));
-    drawingRect.setBottomRight(rect.topLeft() + QPointF(cornerRadius, cornerRadius));
-    cornerGradient.setFocalPoint(drawingRect.bottomRight());
-    cornerGradient.setCenter(drawingRect.bottomRight());
-    p->fillRect(drawingRect, QBrush(cornerGradient));
-
-    // top right
-    drawingRect.setTopRight(rect.topRight() + QPointF(blurRadius, -blurRadius));
-    drawingRect.setBottomLeft(rect.topRight() + QPointF(-cornerRadius, cornerRadius));
-    cornerGradient.setFocalPoint(drawingRect.bottomLeft());
-    cornerGradient.setCenter(drawingRect.bottomLeft());
-    p->fillRect(drawingRect, QBrush(cornerGradient));
-
-    // bottom left
-    drawingRect.setBottomLeft(rect.bottomLeft() + QPointF(-blurRadius, blurRadius));
-    drawingRect.setTopRight(rect.bottomLeft() + QPointF(cornerRadius, -cornerRadius));
-    cornerGradient.setFocalPoint(drawingRect.topRight());
-    cornerGradient.setCenter(drawingRect.topRight());
-    p->fillRect(drawingRect, QBrush(cornerGradient));
-
-    // bottom right
-    drawingRect.setBottomRight(rect.bottomRight() + QPointF(blurRadius, blurRadius));
-    drawingRect.setTopLeft(rect.bottomRight() + QPointF(-cornerRadius, -cornerRadius));
-    cornerGradient.setFocalPoint(drawingRect.topLeft());
-    cornerGradient.setCenter(drawingRect.topLeft());
-    p->fillRect(drawingRect, QBrush(cornerGradient));
-
-    // center
-    // the center has to be drawn, because othervise there would be holes when the shadow is offset,
-    // most of the center will be clipped by the painter
-    p->fillRect(rect.adjusted(0, cornerRadius, 0, -cornerRadius), color);
-    QRectF centerRect = rect.adjusted(cornerRadius, 0, -cornerRadius, 0);
-    centerRect.setHeight(cornerRadius);
-    p->fillRect(centerRect, color);
-    centerRect.moveBottom(rect.bottom());
-    p->fillRect(centerRect, color);
+    p->setRenderHints(QPainter::Antialiasing);
+    p->setPen(QPen(indicator.checkColor, 2));
+    p->setBrush(Qt::NoBrush);
+
+    const double widthOffset = rect.width() - indicatorSize;
+
+    if (indicator.checkState == QStyle::State_NoChange) {
+        const double adjustment = indicatorSize / 4.0f;
+        const double y = rect.center().y() + 1;
 
+        p->drawLine(QLineF(rect.left() + widthOffset + adjustment + 1, y, rect.right() - widthOffset - adjustment, y));
+
+    } else {
+        const auto center = rect.center();
+        const QPointF points[3] = {
+            QPointF(center.x() - indicatorSize / 4.0, center.y()),
+            QPointF(center.x() - indicatorSize / 10.0, center.y() + indicatorSize / 5.0),
+            QPointF(center.x() + indicatorSize / 4.0, center.y() - indicatorSize / 7.5),
+        };
+
+        p->drawPolyline(points, 3);
+    }
     p->restore();
 }
 
+void Style::prewarmCaches() {
+    if (!config.prewarmCaches) {
+        return;
+    }
+
+    // check boxes and radio buttons are in nearly every dialog and menu, and they have a few fixed sizes,
+    // the shadows of menus and combo box popups need a blur, and depend only on the configuration,
+    // the colors are resolved here, as the palette must not be touched outside of the gui thread
+    struct Job {
+        PixmapCache::Key key;
+        qreal dpr;
+        std::function<QImage()> render;
+        bool shareOnDisk;  // rendering it costs more than loading it from the disk cache
+    };
+
+    QList<qreal> dprs;
+    for (const QScreen* screen : QGuiApplication::screens()) {
+        const qreal dpr = screen->devicePixelRatio();
+        if (!dprs.contains(dpr)) {
+            dprs.append(dpr);
+        }
+    }
+    const QList<QSize> sizes = {
+        QSize(pixelMetric(PM_IndicatorWidth), pixelMetric(PM_IndicatorHeight)),
+        QSize(config.checkBoxHoverCircleSize, config.checkBoxHoverCircleSize),  // SE_CheckBoxIndicator
+    };
+    const QPalette palette = QGuiApplication::palette();
+
+    QList<Job> jobs;
+    for (const bool radio : {false, true}) {
+        for (const QStyle::StateFlag checkState : {State_Off, State_On, State_NoChange}) {
+            if (radio && checkState == State_NoChange) {
+                continue;
+            }
+            for (const bool hovered : {false, true}) {
+                const CheckIndicator indicator = checkIndicator(radio, State_Enabled | checkState | (hovered ? State_MouseOver : State_None), palette);
+                for (const QSize& size : sizes) {
+                    for (const qreal dpr : dprs) {
+                        const PixmapCache::Key key = checkIndicatorKey(size, 0, indicator);  // with fractional scaling this covers the indicators which start on a device pixel
+                        if (!pixmapCache.contains(key, dpr)) {
+                            const auto render = [size, dpr, indicator]() {
+                                return PixmapCache::render(size, dpr, [&size, &indicator](QPainter* painter) {
+                                    renderCheckIndicator(painter, QRect(QPoint(0, 0), size), indicator);
+                                });
+                            };
+                            jobs.append({key, dpr, render, false});
+                        }
+                    }
+                }
+            }
+        }
+    }
+    for (const qreal dpr : dprs) {
+        // the nine patches, which menus and popups of any but the smallest size share
+        const RoundedRectShadow shadows[] = {
+            roundedRectShadow(QSizeF(), dpr, config.menuBorderRadius, config.menuShadowBlurRadius, config.menuShadowOffset, getColor(palette, Color::menuShadow)),
+            roundedRectShadow(QSizeF(), dpr, config.menuBorderRadius, config.comboPopupShadowSize, config.comboPopupShadowOffset, getColor(palette, Color::comboBoxPopupShadow)),
+        };
+        for (const RoundedRectShadow& shadow : shadows) {
+            if (shadow.color.alpha() != 0 && !pixmapCache.contains(shadow.key, dpr)) {
+                jobs.append({shadow.key, dpr, [shadow]() { return shadow.render(); }, true});
+            }
+        }
+    }
+    if (jobs.isEmpty()) {
+        return;
+    }
+
+    const bool useDiskCache = config.diskCache;
+    prewarmPool.start([this, jobs, useDiskCache]() {
+        QList<QImage> images;  // in the order of jobs
+        images.reserve(jobs.size());
+        for (const Job& job : jobs) {
+            // another process with the same palette and scale has probably rendered these already
+            const bool onDisk = useDiskCache && job.shareOnDisk;
+            QImage image = onDisk ? diskCache.load(job.key, job.dpr) : QImage();
+            if (image.isNull()) {
+                image = job.render();
+                if (onDisk) {
+                    diskCache.save(job.key, image);
+                }
+            }
+            images.append(image);
+        }
+        if (useDiskCache) {
+            diskCache.prune();
+        }
+
+        // QPixmap can only be created in the gui thread
+        QMetaObject::invokeMethod(
+            this,
+            [this, jobs, images]() {
+                for (qsizetype i = 0; i < jobs.size(); i++) {
+                    if (!pixmapCache.contains(jobs[i].key, jobs[i].dpr)) {
+                        pixmapCache.insert(jobs[i].key, jobs[i].dpr, QPixmap::fromImage(images[i]));
+                    }
+                }
+            },
+            Qt::QueuedConnection);
+    });
+}
+
+WidgetKinds Style::widgetKinds(const QWidget* widget) const {
+    if (!widget) {
+        return WidgetKind::None;
+    }
+
+    const auto it = widgetKindCache.constFind(widget);
+    if (it != widgetKindCache.constEnd()) {
+        return *it;
+    }
+
+    // not polished yet, it may still be under construction, so its class may not be final
+    return classifyWidget(widget);
+}
+
+void Style::widgetDestroyed(QObject* object) {
+    widgetKindCache.remove(object);
+    tabMetricsCache.remove(object);
+    dialHandleRects.remove(object);
+}
+
 inline void Style::installOnQuickItems(QObject* object) const {
 #if HAS_QTQUICK
     if (auto quickItem = qobject_cast<QQuickItem*>(object)) {
@@ -3,12 +3,21 @@
 
 #pragma once
 
+#include <QCache>
 #include <QCommonStyle>
+#include <QDeadlineTimer>
+#include <QFont>
+#include <QHash>
 #include <QPainter>
+#include <QPainterPath>
+#include <QStaticText>
 #include <QStyle>
 #include <QStyleOption>
+#include <QThreadPool>
 #include <QWidget>
 
+#include <utility>
+
 #if HAS_KSTYLE
 #include <KStyle>
 #endif
@@ -16,7 +25,14 @@
 #include "animation_manager.h"
 #include "blur_manager.h"
 #include "config.h"
+#include "event_dispatcher.h"
+#include "opaque_region_manager.h"
+#include "translucency_manager.h"
+#include "utils/disk_cache.h"
+#include "utils/metric_table.h"
+#include "utils/pixmap_cache.h"
 #include "utils/state.h"
+#include "utils/widget_kind.h"
 #include "window_manager.h"
 
 namespace Lilac {
@@ -50,17 +66,24 @@ class Style : public SuperStyle {
     QRect subElementRect(QStyle::SubElement element, const QStyleOption* option, const QWidget* widget = nullptr) const override;
     QRect subControlRect(QStyle::ComplexControl cc, const QStyleOptionComplex* opt, QStyle::SubControl element, const QWidget* widget = nullptr) const override;
     QSize sizeFromContents(QStyle::ContentsType ct, const QStyleOption* opt, const QSize& contentsSize, const QWidget* widget = nullptr) const override;
+    QPixmap generatedIconPixmap(QIcon::Mode iconMode, const QPixmap& pixmap, const QStyleOption* opt) const override;
 
    protected:
     bool eventFilter(QObject* object, QEvent* event) override;
 
    protected:
     const Lilac::Config& config;  // conveninece variable so Config::Get() does not have to be always called;
+    Lilac::EventDispatcher eventDispatcher;  // the only event filter installed on widgets, must be declared before the managers
     mutable Lilac::AnimationManager animationMgr;
+    mutable Lilac::PixmapCache pixmapCache;  // prerendered elements
     mutable Lilac::WindowManager windowMgr;  // for dragging windows by their contents
+    mutable Lilac::TranslucencyManager translucencyMgr;
 #if HAS_KWINDOWSYSTEM
     mutable Lilac::BlurManager blurMgr;
 #endif
+#if HAS_X11
+    mutable Lilac::OpaqueRegionManager opaqueRegionMgr;
+#endif
 
    private:
     struct MenuItemText {
@@ -70,16 +93,106 @@ class Style : public SuperStyle {
     static void sliderGetTickmarks(QList<QLine>* returnList, const QStyleOptionSlider* slider, const QRect& tickmarksRect, const int sliderLen, const int interval);
     static MenuItemText menuItemGetText(const QStyleOptionMenuItem* menu);
     int scrollbarGetSliderLength(const QStyleOptionSlider* bar) const;
+    qreal scrollBarOverlayOpacity(const QStyleOptionSlider* bar, const QWidget* widget) const;  // only for Config::scrollBarOverlay
+    // the parts of CE_ScrollBarSlider and PE_IndicatorArrow* which need no option, so that the callers do not have to copy theirs
+    void drawScrollBarSlider(QPainter* p, const QRect& rect, const bool horizontal, const Lilac::State& state, const QPalette& palette, const QWidget* widget) const;
+    void drawIndicatorArrow(QPainter* p, const QStyle::PrimitiveElement arrow, const QRect& rect, const Lilac::State& state, const QPalette& palette, const QWidget* widget) const;
     int getTextFlags(const QStyleOption* opt) const;
     QRect tabBarGetTabRect(const QStyleOptionTab* tab) const;
     static bool tabIsHorizontal(const QTabBar::Shape& tabShape);
-    QRect tabBarTabIconRect(const QStyleOptionTab* tab, const Lilac::State& state, const QRect& textRect) const;
-    static void drawDropShadow(QPainter* p, const QRectF& rect, const qreal cornerRadius, const qreal blurRadius, const QPointF offset, const QColor color);
+    QPainterPath tabShapePath(QRectF rect, const QTabBar::Shape shape, const bool isSelected) const;  // rect is adjusted for the outline inside
+    QRect tabBarTabIconRect(const QStyleOptionTab* tab, const Lilac::State& state, const QRect& textRect, const QWidget* widget) const;
+    // everything a check box or radio button indicator depends on, so that it can be drawn without an option, on any thread
+    struct CheckIndicator {
+        bool radio = false;
+        QStyle::State checkState = QStyle::State_Off;  // State_Off, State_On or State_NoChange
+        bool hoverCircle = false;
+        int cornerRadius = -1;  // -1 for a circle
+        QColor hoverCircleColor;
+        QColor outlineColor;  // only if checkState is State_Off
+        QColor insideColor;   // only if checkState is not State_Off
+        QColor checkColor;    // only if checkState is not State_Off
+    };
+    CheckIndicator checkIndicator(const bool radio, const QStyle::State styleState, const QPalette& palette) const;
+    static PixmapCache::Key checkIndicatorKey(const QSize& size, const quint32 phaseKey, const CheckIndicator& indicator);  // phaseKey of PixmapCache::Placement
+    void drawCheckIndicator(QPainter* p, const QRect& rect, const CheckIndicator& indicator) const;  // cached
+    static void renderCheckIndicator(QPainter* p, const QRect& rect, const CheckIndicator& indicator);
     inline void installOnQuickItems(QObject* object) const;  // does something only if HAS_QTQUICK
+    WidgetKinds widgetKinds(const QWidget* widget) const;     // cached at polish time, widget may be nullptr
+
+   private slots:
+    void widgetDestroyed(QObject* object);
+    void updateMetrics();  // fills the metric tables, on top of the compile time ones
+    void prewarmCaches();  // renders common assets on a worker thread, if enabled
+
+   private:
+    struct TabMetrics {
+        QSize textSize;  // invalid if there is no text
+        QSize iconSize;  // invalid if there is no icon
+    };
+    // the measured parts of a tab, they do not depend on the tab's position,
+    // so they stay the same while tabs are dragged around or scrolled
+    struct TabMetricsKey {
+        QString text;
+        QFont font;
+        int logicalDpi;
+        qint64 iconCacheKey;
+        QSize iconSize;
+        int textFlags;
+        QTabBar::Shape shape;
+        int alignment;
+
+        friend size_t qHash(const TabMetricsKey& key, size_t seed = 0) {
+            return qHashMulti(seed, key.text, key.font, key.logicalDpi, key.iconCacheKey, key.iconSize.width(), key.iconSize.height(), key.textFlags, int(key.shape), key.alignment);
+        }
+        friend bool operator==(const TabMetricsKey& lhs, const TabMetricsKey& rhs) {
+            return lhs.text == rhs.text && lhs.font == rhs.font && lhs.logicalDpi == rhs.logicalDpi && lhs.iconCacheKey == rhs.iconCacheKey && lhs.iconSize == rhs.iconSize &&
+                   lhs.textFlags == rhs.textFlags && lhs.shape == rhs.shape && lhs.alignment == rhs.alignment;
+        }
+    };
+    QSize progressBarDefaultLabelSize(const QStyleOptionProgressBar* bar, const QWidget* widget) const;  // size of "100%", cached per font and dpi
+    TabMetrics tabBarTabMetrics(const QStyleOptionTab* tab, const int textFlags, const QSize& iconSize, const QWidget* widget) const;  // cached per tab bar
+
+    // single line labels which are painted over and over with the same text, like the ones of menu items,
+    // the laid out text is cached, so that only the glyphs have to be drawn
+    struct LabelTextKey {
+        QString text;
+        QFont font;
+        bool showMnemonic;
+
+        friend size_t qHash(const LabelTextKey& key, size_t seed = 0) {
+            return qHashMulti(seed, key.text, key.font, key.showMnemonic);
+        }
+        friend bool operator==(const LabelTextKey& lhs, const LabelTextKey& rhs) {
+            return lhs.text == rhs.text && lhs.font == rhs.font && lhs.showMnemonic == rhs.showMnemonic;
+        }
+    };
+    void drawLabelText(QPainter* p, const QRect& rect, const int flags, const QString& text) const;  // like p->drawText(rect, flags, text), with the painter's font
+
+    struct DialHandle {
+        QRect dialRect;  // the rect of the dial the handle was computed for
+        int sliderPosition;
+        QRect handleRect;
+    };
+
+    struct ScrollBarOverlayState {
+        QDeadlineTimer hold;  // the scrollbar stays visible until this expires
+        bool repaintPending = false;
+    };
 
    private:
 #if HAS_KSTYLE
     ControlElement kstyle_CE_CapacityBar;
 #endif
+    mutable QHash<const QWidget*, ScrollBarOverlayState> scrollBarOverlayStates;
+    QHash<const QObject*, WidgetKinds> widgetKindCache;
+    MetricTable<QStyle::PixelMetric> pixelMetrics;  // answers of pixelMetric() and styleHint() which depend neither on the option nor on the widget
+    MetricTable<QStyle::StyleHint> styleHints;
+    mutable QHash<const QObject*, QHash<TabMetricsKey, TabMetrics>> tabMetricsCache;  // only for polished tab bars
+    mutable QHash<const QObject*, DialHandle> dialHandleRects;                         // last painted handle of polished dials
+    mutable QHash<std::pair<QFont, int>, QSize> progressBarLabelSizes;  // by font and logical dpi
+    mutable QCache<LabelTextKey, QStaticText> labelTexts{1024};
+    const Lilac::DiskCache diskCache;  // only used from prewarmPool
+    QThreadPool prewarmPool;  // must be declared last, so that it waits for the prewarm before anything else is destroyed
 };
 }  // namespace Lilac
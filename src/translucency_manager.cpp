@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#if HAS_KWINDOWSYSTEM && HAS_X11
+#include <KWindowSystem>
+#include <KX11Extras>
+#endif
+
+#include <QWindow>
+
+#include "translucency_manager.h"
+
+namespace Lilac {
+
+TranslucencyManager::TranslucencyManager(QObject* parent)
+    : QObject(parent) {
+#if HAS_KWINDOWSYSTEM && HAS_X11
+    if (KWindowSystem::isPlatformX11()) {
+        connect(KX11Extras::self(), &KX11Extras::compositingChanged, this, qOverload<>(&TranslucencyManager::updateTranslucency));
+    }
+#endif
+}
+
+bool TranslucencyManager::shouldManageWidget(const QWidget* widget) {
+    return widget->inherits("QMenu") ||
+           widget->inherits("QTipLabel") ||
+           widget->inherits("QDockWidget") ||
+           widget->inherits("QComboBoxPrivateContainer");
+}
+
+bool TranslucencyManager::compositingActive() {
+#if HAS_KWINDOWSYSTEM && HAS_X11
+    if (KWindowSystem::isPlatformX11()) {
+        return KX11Extras::compositingActive();
+    }
+#endif
+    return true;  // wayland is always composited, and elsewhere there is no way to tell
+}
+
+bool TranslucencyManager::hasAlphaChannel(const QWidget* widget) {
+    const QWindow* window = widget->window()->windowHandle();
+    if (window && window->handle()) {
+        return window->format().hasAlpha();
+    }
+    return widget->testAttribute(Qt::WA_TranslucentBackground);  // created with the attribute, or painted into a pixmap
+}
+
+void TranslucencyManager::registerWidget(QWidget* widget) {
+    registeredWidgets.insert(widget);
+    connect(widget, &QWidget::destroyed, this, [widget, this]() { this->registeredWidgets.remove(widget); });
+    updateTranslucency(widget);
+}
+
+void TranslucencyManager::unregisterWidget(QWidget* widget) {
+    registeredWidgets.remove(widget);
+    disconnect(widget, &QWidget::destroyed, this, nullptr);
+    setTranslucent(widget, false);
+}
+
+bool TranslucencyManager::needsTranslucency(const QWidget* widget) {
+    // (un)docking does not notify the style, and a floating one has rounded corners even without a compositor
+    if (widget->inherits("QDockWidget")) {
+        return true;
+    }
+    return compositingActive();
+}
+
+void TranslucencyManager::updateTranslucency() {
+    for (const auto& widget : registeredWidgets) {
+        updateTranslucency(widget);
+    }
+}
+
+void TranslucencyManager::setTranslucent(QWidget* widget, const bool translucent) {
+    widget->setAttribute(Qt::WA_TranslucentBackground, translucent);
+    if (!translucent) {
+        // set along with WA_TranslucentBackground, but not cleared with it, the background would not be filled
+        widget->setAttribute(Qt::WA_NoSystemBackground, false);
+    }
+}
+
+void TranslucencyManager::updateTranslucency(QWidget* widget) {
+    const bool translucent = needsTranslucency(widget);
+    if (widget->testAttribute(Qt::WA_TranslucentBackground) == translucent) {
+        return;
+    }
+
+    QWindow* window = widget->windowHandle();
+    if (window && window->handle()) {
+        if (widget->isVisible()) {
+            connect(
+                window, &QWindow::visibleChanged, this, [widget, this]() {
+                    if (this->registeredWidgets.contains(widget)) {
+                        this->updateTranslucency(widget);  // waits again if it was shown meanwhile
+                    }
+                },
+                Qt::ConnectionType(Qt::QueuedConnection | Qt::SingleShotConnection));
+            return;
+        }
+        // the attribute changes the format only of a window which is not created, it is created again when shown
+        window->destroy();
+    }
+    setTranslucent(widget, translucent);
+}
+
+}  // namespace Lilac
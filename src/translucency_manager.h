@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#pragma once
+
+#include <QObject>
+#include <QSet>
+#include <QWidget>
+
+namespace Lilac {
+
+// Gives menus, tooltips and combo box popups a translucent background, which their rounded corners, shadows
+// and the menu opacity need, but only while a compositor can show it, an opaque window needs no alpha channel
+// and nothing has to blend it. Dock widgets are always translucent, the attribute does nothing while they are docked,
+// and it has to be set before they are floated, which creates their window.
+//
+// Qt picks the format of a window when it creates it, so a hidden window is destroyed to be created again with the new one,
+// and a visible window keeps its format until it is hidden. The painting follows the format, see hasAlphaChannel().
+class TranslucencyManager : public QObject {
+    Q_OBJECT
+   public:
+    explicit TranslucencyManager(QObject* parent = nullptr);
+
+    static bool shouldManageWidget(const QWidget* widget);
+    static bool compositingActive();
+    // whether the window the widget paints into can be translucent, decides between clearing and filling its background
+    static bool hasAlphaChannel(const QWidget* widget);
+
+    void registerWidget(QWidget* widget);    // this does not check for shouldManageWidget
+    void unregisterWidget(QWidget* widget);  // the widget is left opaque
+
+   protected:
+    static bool needsTranslucency(const QWidget* widget);
+
+   public slots:
+    void updateTranslucency();
+
+   private:
+    static void setTranslucent(QWidget* widget, const bool translucent);
+    void updateTranslucency(QWidget* widget);
+
+   private:
+    QSet<QWidget*> registeredWidgets;
+};
+
+}  // namespace Lilac
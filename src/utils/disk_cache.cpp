@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <cstring>
+
+#include "disk_cache.h"
+
+namespace Lilac {
+
+namespace {
+struct Header {
+    char magic[4];
+    quint32 formatVersion;
+    quint64 key;
+    qint32 width;
+    qint32 height;
+    qint32 bytesPerLine;
+    qint32 dprPercent;
+};
+static_assert(sizeof(Header) <= 64);
+
+constexpr char magic[4] = {'L', 'L', 'A', 'C'};
+constexpr qint64 pixelsOffset = 64;  // keeps the pixels aligned for QImage
+
+int dprPercent(qreal dpr) {
+    return qRound(dpr * 100);
+}
+}  // namespace
+
+DiskCache::DiskCache()
+    : baseDirectory(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/lilac")),
+      directory(baseDirectory + QStringLiteral("/%1-%2-qt%3").arg(formatVersion).arg(QLatin1String(LILAC_RENDER_HASH), QLatin1String(qVersion()))) {
+}
+
+QImage DiskCache::load(quint64 key, qreal dpr) const {
+    const QString path = filePath(key, dpr);
+    auto* file = new QFile(path);
+    if (!file->open(QIODevice::ReadOnly)) {
+        delete file;
+        return QImage();
+    }
+
+    const qint64 size = file->size();
+    const uchar* data = size > pixelsOffset ? file->map(0, size) : nullptr;
+    Header header;
+    if (data) {
+        std::memcpy(&header, data, sizeof(Header));
+    }
+
+    const bool valid = data &&
+                       std::memcmp(header.magic, magic, sizeof(magic)) == 0 &&
+                       header.formatVersion == formatVersion &&
+                       header.key == key &&
+                       header.dprPercent == dprPercent(dpr) &&
+                       header.width > 0 && header.height > 0 &&
+                       header.bytesPerLine >= header.width * 4 &&
+                       pixelsOffset + qint64(header.bytesPerLine) * header.height == size;
+    if (!valid) {
+        // of another format, written by something else or truncated, it would fail again next time,
+        // the pixels are not checked, QSaveFile only renames complete files into place
+        delete file;
+        QFile::remove(path);
+        return QImage();
+    }
+
+    QImage image(
+        data + pixelsOffset,
+        header.width,
+        header.height,
+        header.bytesPerLine,
+        QImage::Format_ARGB32_Premultiplied,
+        [](void* file) { delete static_cast<QFile*>(file); },  // unmaps
+        file);
+    image.setDevicePixelRatio(dpr);
+    return image;
+}
+
+void DiskCache::save(quint64 key, const QImage& image) const {
+    if (image.isNull() || image.format() != QImage::Format_ARGB32_Premultiplied || !QDir().mkpath(directory)) {
+        return;
+    }
+
+    Header header;
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.formatVersion = formatVersion;
+    header.key = key;
+    header.width = image.width();
+    header.height = image.height();
+    header.bytesPerLine = image.bytesPerLine();
+    header.dprPercent = dprPercent(image.devicePixelRatio());
+
+    QByteArray headerBytes(pixelsOffset, '\0');
+    std::memcpy(headerBytes.data(), &header, sizeof(Header));
+
+    // the file only appears under its name on commit, so no other process can read it half written
+    QSaveFile file(filePath(key, image.devicePixelRatio()));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    file.write(headerBytes);
+    file.write(reinterpret_cast<const char*>(image.constBits()), image.sizeInBytes());
+    file.commit();
+}
+
+void DiskCache::prune(int maxFiles, int maxUnusedDays) const {
+    // listing the directories on every start would cost more than the cache saves, the stamp limits it to once a day
+    const QString stampPath = directory + QLatin1Char('/') + QLatin1String(lastUsedStamp);
+    const QFileInfo stampInfo(stampPath);
+    if (stampInfo.exists() && stampInfo.lastModified() > QDateTime::currentDateTime().addDays(-1)) {
+        return;
+    }
+
+    // other installed builds, or a flatpak next to the host, share the base directory and use their own directories,
+    // so those are left alone until none of them has used theirs for a while
+    QFile stamp(stampPath);
+    if (QDir().mkpath(directory) && stamp.open(QIODevice::WriteOnly)) {
+        stamp.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+        stamp.close();
+    }
+
+    QDir base(baseDirectory);
+    const QString current = QFileInfo(directory).fileName();
+    const QDateTime unusedSince = QDateTime::currentDateTime().addDays(-maxUnusedDays);
+    for (const QString& entry : base.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+        if (entry == current) {
+            continue;
+        }
+        const QFileInfo otherStamp(base.filePath(entry) + QLatin1Char('/') + QLatin1String(lastUsedStamp));
+        const QDateTime lastUsed = otherStamp.exists() ? otherStamp.lastModified() : QFileInfo(base.filePath(entry)).lastModified();
+        if (lastUsed < unusedSince) {
+            QDir(base.filePath(entry)).removeRecursively();
+        }
+    }
+
+    QFileInfoList files = QDir(directory).entryInfoList({QStringLiteral("*.bin")}, QDir::Files);
+    if (files.size() <= maxFiles) {
+        return;
+    }
+    std::sort(files.begin(), files.end(), [](const QFileInfo& lhs, const QFileInfo& rhs) { return lhs.lastModified() > rhs.lastModified(); });
+    for (qsizetype i = maxFiles; i < files.size(); i++) {
+        QFile::remove(files[i].filePath());
+    }
+}
+
+QString DiskCache::filePath(quint64 key, qreal dpr) const {
+    return QStringLiteral("%1/%2-%3.bin").arg(directory).arg(key, 16, 16, QLatin1Char('0')).arg(dprPercent(dpr));
+}
+
+}  // namespace Lilac
@@ -0,0 +1,41 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#pragma once
+
+#include <QImage>
+#include <QString>
+
+namespace Lilac {
+
+// Prerendered elements shared between processes, in $XDG_CACHE_HOME/lilac/.
+// Every image is one file with a small header followed by the raw pixels, so it can be mapped into memory as it is.
+// Files are written atomically, and files which do not pass the checks on load are removed,
+// the key must contain everything the image depends on, like for PixmapCache.
+// Opening and mapping a file is not free, so this is only worth it for elements which take real work to render, like blurred shadows.
+//
+// All functions may be called from any thread.
+class DiskCache {
+   public:
+    DiskCache();
+
+    // null image if there is no valid entry, the image uses the mapped file until it is destroyed
+    QImage load(quint64 key, qreal dpr) const;
+    void save(quint64 key, const QImage& image) const;  // image must be Format_ARGB32_Premultiplied
+
+    // at most once a day: marks this version as used, removes the directories of other versions which were not used for maxUnusedDays,
+    // and the oldest files if there are more than maxFiles
+    void prune(int maxFiles = 1024, int maxUnusedDays = 30) const;
+
+   private:
+    QString filePath(quint64 key, qreal dpr) const;
+
+   private:
+    static constexpr quint32 formatVersion = 2;  // of the files, the rendering is covered by LILAC_RENDER_HASH
+    static constexpr char lastUsedStamp[] = "last-used";
+
+    QString baseDirectory;  // $XDG_CACHE_HOME/lilac
+    QString directory;      // subdirectory for this format, the sources that render the images (LILAC_RENDER_HASH) and the Qt version
+};
+
+}  // namespace Lilac
@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#include "icon_effects.h"
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#define LILAC_SSE2 1
+#if defined(__GNUC__)
+#define LILAC_AVX2 1  // compiled for avx2 separately, used if the cpu supports it
+#endif
+#endif
+
+namespace Lilac {
+
+namespace {
+// luminance weights, out of 256
+constexpr int redWeight = 77;
+constexpr int greenWeight = 150;
+constexpr int blueWeight = 29;
+
+/*
+ * All the kernels keep every pixel as one 32 bit lane (0xAARRGGBB) and split it into channels in lanes of their own,
+ * the products of two channels fit into 16 bits, so the 16 bit multiplication works on the 32 bit lanes,
+ * which means that sse2 is enough and the vector and scalar results are identical.
+ */
+
+inline quint32 desaturatePixel(const quint32 pixel, const int opacity) {
+    const quint32 alpha = pixel >> 24;
+    const quint32 red = (pixel >> 16) & 0xff;
+    const quint32 green = (pixel >> 8) & 0xff;
+    const quint32 blue = pixel & 0xff;
+    const quint32 gray = ((red * redWeight + green * greenWeight + blue * blueWeight) >> 8) * opacity >> 8;
+    return ((alpha * opacity >> 8) << 24) | (gray << 16) | (gray << 8) | gray;
+}
+
+// tint is the color, channels already in the low byte of each
+inline quint32 tintChannel(const quint32 channel, const quint32 tint, const quint32 alpha, const int strength) {
+    return (channel * (256 - strength) + (tint * alpha >> 8) * strength) >> 8;
+}
+
+inline quint32 tintPixel(const quint32 pixel, const QRgb color, const int strength) {
+    const quint32 alpha = pixel >> 24;
+    const quint32 red = tintChannel((pixel >> 16) & 0xff, qRed(color), alpha, strength);
+    const quint32 green = tintChannel((pixel >> 8) & 0xff, qGreen(color), alpha, strength);
+    const quint32 blue = tintChannel(pixel & 0xff, qBlue(color), alpha, strength);
+    return (alpha << 24) | (red << 16) | (green << 8) | blue;
+}
+
+#if LILAC_SSE2
+int desaturateSse2(quint32* pixels, const int count, const int opacity) {
+    const __m128i mask = _mm_set1_epi32(0xff);
+    const __m128i redW = _mm_set1_epi32(redWeight);
+    const __m128i greenW = _mm_set1_epi32(greenWeight);
+    const __m128i blueW = _mm_set1_epi32(blueWeight);
+    const __m128i opacityV = _mm_set1_epi32(opacity);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i pixel = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+        const __m128i alpha = _mm_srli_epi32(pixel, 24);
+        const __m128i red = _mm_and_si128(_mm_srli_epi32(pixel, 16), mask);
+        const __m128i green = _mm_and_si128(_mm_srli_epi32(pixel, 8), mask);
+        const __m128i blue = _mm_and_si128(pixel, mask);
+
+        __m128i gray = _mm_add_epi32(_mm_add_epi32(_mm_mullo_epi16(red, redW), _mm_mullo_epi16(green, greenW)), _mm_mullo_epi16(blue, blueW));
+        gray = _mm_srli_epi32(_mm_mullo_epi16(_mm_srli_epi32(gray, 8), opacityV), 8);
+        const __m128i newAlpha = _mm_srli_epi32(_mm_mullo_epi16(alpha, opacityV), 8);
+
+        const __m128i result = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(newAlpha, 24), _mm_slli_epi32(gray, 16)),
+                                            _mm_or_si128(_mm_slli_epi32(gray, 8), gray));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), result);
+    }
+    return i;
+}
+
+int tintSse2(quint32* pixels, const int count, const QRgb color, const int strength) {
+    const __m128i mask = _mm_set1_epi32(0xff);
+    const __m128i inverseStrength = _mm_set1_epi32(256 - strength);
+    const __m128i strengthV = _mm_set1_epi32(strength);
+    const __m128i tintRed = _mm_set1_epi32(qRed(color));
+    const __m128i tintGreen = _mm_set1_epi32(qGreen(color));
+    const __m128i tintBlue = _mm_set1_epi32(qBlue(color));
+
+    const auto channel = [&](const __m128i value, const __m128i tint, const __m128i alpha) {
+        const __m128i premultipliedTint = _mm_srli_epi32(_mm_mullo_epi16(tint, alpha), 8);
+        return _mm_srli_epi32(_mm_add_epi32(_mm_mullo_epi16(value, inverseStrength), _mm_mullo_epi16(premultipliedTint, strengthV)), 8);
+    };
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m128i pixel = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+        const __m128i alpha = _mm_srli_epi32(pixel, 24);
+        const __m128i red = channel(_mm_and_si128(_mm_srli_epi32(pixel, 16), mask), tintRed, alpha);
+        const __m128i green = channel(_mm_and_si128(_mm_srli_epi32(pixel, 8), mask), tintGreen, alpha);
+        const __m128i blue = channel(_mm_and_si128(pixel, mask), tintBlue, alpha);
+
+        const __m128i result = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(alpha, 24), _mm_slli_epi32(red, 16)),
+                                            _mm_or_si128(_mm_slli_epi32(green, 8), blue));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), result);
+    }
+    return i;
+}
+#endif
+
+#if LILAC_AVX2
+__attribute__((target("avx2"))) int desaturateAvx2(quint32* pixels, const int count, const int opacity) {
+    const __m256i mask = _mm256_set1_epi32(0xff);
+    const __m256i redW = _mm256_set1_epi32(redWeight);
+    const __m256i greenW = _mm256_set1_epi32(greenWeight);
+    const __m256i blueW = _mm256_set1_epi32(blueWeight);
+    const __m256i opacityV = _mm256_set1_epi32(opacity);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i pixel = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+        const __m256i alpha = _mm256_srli_epi32(pixel, 24);
+        const __m256i red = _mm256_and_si256(_mm256_srli_epi32(pixel, 16), mask);
+        const __m256i green = _mm256_and_si256(_mm256_srli_epi32(pixel, 8), mask);
+        const __m256i blue = _mm256_and_si256(pixel, mask);
+
+        __m256i gray = _mm256_add_epi32(_mm256_add_epi32(_mm256_mullo_epi16(red, redW), _mm256_mullo_epi16(green, greenW)), _mm256_mullo_epi16(blue, blueW));
+        gray = _mm256_srli_epi32(_mm256_mullo_epi16(_mm256_srli_epi32(gray, 8), opacityV), 8);
+        const __m256i newAlpha = _mm256_srli_epi32(_mm256_mullo_epi16(alpha, opacityV), 8);
+
+        const __m256i result = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(newAlpha, 24), _mm256_slli_epi32(gray, 16)),
+                                               _mm256_or_si256(_mm256_slli_epi32(gray, 8), gray));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i), result);
+    }
+    return i;
+}
+
+__attribute__((target("avx2"))) int tintAvx2(quint32* pixels, const int count, const QRgb color, const int strength) {
+    const __m256i mask = _mm256_set1_epi32(0xff);
+    const __m256i inverseStrength = _mm256_set1_epi32(256 - strength);
+    const __m256i strengthV = _mm256_set1_epi32(strength);
+    const __m256i tintRed = _mm256_set1_epi32(qRed(color));
+    const __m256i tintGreen = _mm256_set1_epi32(qGreen(color));
+    const __m256i tintBlue = _mm256_set1_epi32(qBlue(color));
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m256i pixel = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pixels + i));
+        const __m256i alpha = _mm256_srli_epi32(pixel, 24);
+        __m256i channels[3] = {_mm256_and_si256(_mm256_srli_epi32(pixel, 16), mask),
+                               _mm256_and_si256(_mm256_srli_epi32(pixel, 8), mask),
+                               _mm256_and_si256(pixel, mask)};
+        const __m256i tints[3] = {tintRed, tintGreen, tintBlue};
+        for (int c = 0; c < 3; c++) {  // a lambda would not inherit the target attribute
+            const __m256i premultipliedTint = _mm256_srli_epi32(_mm256_mullo_epi16(tints[c], alpha), 8);
+            channels[c] = _mm256_srli_epi32(_mm256_add_epi32(_mm256_mullo_epi16(channels[c], inverseStrength), _mm256_mullo_epi16(premultipliedTint, strengthV)), 8);
+        }
+
+        const __m256i result = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(alpha, 24), _mm256_slli_epi32(channels[0], 16)),
+                                               _mm256_or_si256(_mm256_slli_epi32(channels[1], 8), channels[2]));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(pixels + i), result);
+    }
+    return i;
+}
+
+bool hasAvx2() {
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+#endif
+}  // namespace
+
+void desaturateImage(QImage* image, const int opacity) {
+    Q_ASSERT(image->format() == QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < image->height(); y++) {
+        auto* pixels = reinterpret_cast<quint32*>(image->scanLine(y));
+        const int count = image->width();
+        int i = 0;
+#if LILAC_AVX2
+        if (hasAvx2()) {
+            i = desaturateAvx2(pixels, count, opacity);
+        }
+#endif
+#if LILAC_SSE2
+        i += desaturateSse2(pixels + i, count - i, opacity);
+#endif
+        for (; i < count; i++) {
+            pixels[i] = desaturatePixel(pixels[i], opacity);
+        }
+    }
+}
+
+void tintImage(QImage* image, const QRgb color, const int strength) {
+    Q_ASSERT(image->format() == QImage::Format_ARGB32_Premultiplied);
+    for (int y = 0; y < image->height(); y++) {
+        auto* pixels = reinterpret_cast<quint32*>(image->scanLine(y));
+        const int count = image->width();
+        int i = 0;
+#if LILAC_AVX2
+        if (hasAvx2()) {
+            i = tintAvx2(pixels, count, color, strength);
+        }
+#endif
+#if LILAC_SSE2
+        i += tintSse2(pixels + i, count - i, color, strength);
+#endif
+        for (; i < count; i++) {
+            pixels[i] = tintPixel(pixels[i], color, strength);
+        }
+    }
+}
+
+}  // namespace Lilac
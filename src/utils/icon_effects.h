@@ -0,0 +1,20 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#pragma once
+
+#include <QImage>
+#include <QRgb>
+
+namespace Lilac {
+
+// Per pixel effects for the generated icon pixmaps, they work in place on a Format_ARGB32_Premultiplied image,
+// with AVX2 or SSE2 if the cpu has it and a scalar loop otherwise, all of them give the same result.
+
+// to gray by luminance, then everything, alpha included, is scaled by opacity: 0 - 256
+void desaturateImage(QImage* image, const int opacity);
+
+// color is mixed into the visible pixels by strength: 0 - 256, the alpha stays the same, like with QPainter::CompositionMode_SourceAtop
+void tintImage(QImage* image, const QRgb color, const int strength);
+
+}  // namespace Lilac
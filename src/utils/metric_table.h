@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#pragma once
+
+#include <QtGlobal>
+
+#include <initializer_list>
+
+namespace Lilac {
+
+// Values of QStyle::PixelMetric or QStyle::StyleHint which do not depend on the option or the widget,
+// looked up by the enum value instead of going through a switch.
+// It can be filled at compile time, setting a key outside of the table then fails to compile.
+template <typename Enum, int Size = 256>
+class MetricTable {
+   public:
+    constexpr MetricTable() = default;
+
+    constexpr void set(const Enum key, const int value) {
+        values[key] = value;
+        present[key] = true;
+    }
+
+    constexpr void set(const std::initializer_list<Enum> keys, const int value) {
+        for (const Enum key : keys) {
+            set(key, value);
+        }
+    }
+
+    // value is left untouched if there is no entry for key
+    constexpr bool find(const Enum key, int* value) const {
+        const qint64 index = static_cast<qint64>(key);
+        if (index < 0 || index >= Size || !present[index]) {
+            return false;
+        }
+        *value = values[index];
+        return true;
+    }
+
+   private:
+    int values[Size] = {};
+    bool present[Size] = {};
+};
+
+}  // namespace Lilac
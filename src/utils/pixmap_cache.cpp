@@ -0,0 +1,110 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#include <QGuiApplication>
+#include <QPaintDevice>
+#include <QPainter>
+#include <QSet>
+#include <QtMath>
+
+#include "pixmap_cache.h"
+
+namespace Lilac {
+
+PixmapCache::PixmapCache(int maxSizeKiB)
+    : maxSizeKiB(maxSizeKiB) {
+}
+
+bool PixmapCache::find(Key key, qreal dpr, QPixmap* pixmap) const {
+    const auto bucket = buckets.find(bucketId(dpr));
+    if (bucket == buckets.end()) {
+        return false;
+    }
+    const QPixmap* cached = bucket->second.object(key);
+    if (!cached) {
+        return false;
+    }
+    *pixmap = *cached;
+    return true;
+}
+
+bool PixmapCache::contains(Key key, qreal dpr) const {
+    const auto bucket = buckets.find(bucketId(dpr));
+    return bucket != buckets.end() && bucket->second.contains(key);
+}
+
+void PixmapCache::insert(Key key, qreal dpr, const QPixmap& pixmap) {
+    const int id = bucketId(dpr);
+    auto bucket = buckets.find(id);
+    if (bucket == buckets.end()) {
+        if (buckets.size() >= maxBuckets) {
+            pruneDevicePixelRatios();
+        }
+        bucket = buckets.try_emplace(id, maxSizeKiB).first;
+    }
+
+    const qint64 sizeKiB = qMax<qint64>(1, qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8 / 1024);
+    bucket->second.insert(key, new QPixmap(pixmap), sizeKiB);
+}
+
+void PixmapCache::clear() {
+    buckets.clear();
+}
+
+void PixmapCache::pruneDevicePixelRatios(const QScreen* removedScreen) {
+    QSet<int> activeIds;
+    for (const QScreen* screen : QGuiApplication::screens()) {
+        if (screen != removedScreen) {
+            activeIds.insert(bucketId(screen->devicePixelRatio()));
+        }
+    }
+
+    for (auto it = buckets.begin(); it != buckets.end();) {
+        if (activeIds.contains(it->first)) {
+            ++it;
+        } else {
+            it = buckets.erase(it);
+        }
+    }
+}
+
+QImage PixmapCache::render(const QSize& size, qreal dpr, const std::function<void(QPainter*)>& paint) {
+    return render(size, dpr, QPointF(0, 0), paint);
+}
+
+QImage PixmapCache::render(const QSize& size, qreal dpr, const QPointF& phase, const std::function<void(QPainter*)>& paint) {
+    QImage image(qCeil(size.width() * dpr + phase.x()), qCeil(size.height() * dpr + phase.y()), QImage::Format_ARGB32_Premultiplied);
+    image.setDevicePixelRatio(dpr);
+    image.fill(Qt::transparent);
+    QPainter painter(&image);
+    painter.translate(phase / dpr);
+    paint(&painter);
+    painter.end();
+    return image;
+}
+
+bool PixmapCache::canBlit(const QPainter* p) {
+    // scaled or rotated the pixmap would have to be resampled, fractional scaling is handled by placement()
+    return p->transform().type() <= QTransform::TxTranslate;
+}
+
+PixmapCache::Placement PixmapCache::placement(const QPainter* p, const QPoint& origin) {
+    const qreal dpr = p->device()->devicePixelRatioF();
+    // the device transform includes the position of the widget in its window, which decides the phase as well,
+    // it is rounded to 1/64 of a device pixel, so that rounding errors of the transform do not create new keys
+    const QPointF device = p->deviceTransform().map(QPointF(origin));
+    const qint64 x = qRound64(device.x() * 64);
+    const qint64 y = qRound64(device.y() * 64);
+
+    Placement placement;
+    placement.phase = QPointF((x & 63) / 64.0, (y & 63) / 64.0);
+    placement.position = QPointF(origin) - placement.phase / dpr;
+    placement.phaseKey = quint32(x & 63) | (quint32(y & 63) << 6);
+    return placement;
+}
+
+int PixmapCache::bucketId(qreal dpr) {
+    return qRound(dpr * 100);
+}
+
+}  // namespace Lilac
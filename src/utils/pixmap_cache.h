@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#pragma once
+
+#include <QCache>
+#include <QHashFunctions>
+#include <QImage>
+#include <QPainter>
+#include <QPixmap>
+#include <QScreen>
+
+#include <functional>
+#include <map>
+
+namespace Lilac {
+
+// Bounded cache of prerendered elements.
+// The key has to contain everything the pixmap depends on (size, colors...) except for the device pixel ratio,
+// use PixmapCache::key() to build it, from integral and floating point values only.
+//
+// Every device pixel ratio has its own bounded set of pixmaps, so that moving a window to a screen
+// with a different scale does not evict the pixmaps of the other screen,
+// the sets of device pixel ratios no screen has anymore are dropped.
+class PixmapCache {
+   public:
+    using Key = quint64;
+
+    // one for every element that is cached, so that equal parameters of different elements do not collide
+    enum Element : quint32 {
+        TabShape = 1,
+        DialRing,
+        SliderBackground,
+        ProgressBarGroove,
+        CheckIndicator,
+        GeneratedIcon,
+        Shadow,
+    };
+
+    explicit PixmapCache(int maxSizeKiB = 8 * 1024);  // the limit is per device pixel ratio
+
+    template <typename... Args>
+    static Key key(Element element, const Args&... args) {
+        // two differently seeded hashes, so the key has 64 bits even where size_t has only 32
+        const quint64 high = qHashMulti(0x6c696c61, quint32(element), args...);
+        const quint64 low = qHashMulti(0x63616368, quint32(element), args...);
+        return (high << 32) ^ low;
+    }
+
+    // pixmap is left untouched if there is no entry for key
+    bool find(Key key, qreal dpr, QPixmap* pixmap) const;
+    bool contains(Key key, qreal dpr) const;
+    void insert(Key key, qreal dpr, const QPixmap& pixmap);
+    void clear();
+
+    // drops the pixmaps of device pixel ratios which no screen, except for removedScreen, has
+    void pruneDevicePixelRatios(const QScreen* removedScreen = nullptr);
+
+    // caching only makes sense if the pixmap can be blitted 1:1 to the device
+    static bool canBlit(const QPainter* p);
+
+    // Where the pixmap of an element at origin (in the painter's coordinates) has to be drawn, so that it is blitted 1:1.
+    // With a fractional device pixel ratio origin is mostly not on a device pixel, so the pixmap is drawn at the device pixel
+    // before it, and its contents are rendered shifted by the rest, the phase. Only if canBlit(p).
+    struct Placement {
+        QPointF position;  // logical, to draw the pixmap at
+        QPointF phase;     // in device pixels, each between 0 and 1, to render the pixmap with
+        quint32 phaseKey;  // the phase, has to be a part of the key
+    };
+    static Placement placement(const QPainter* p, const QPoint& origin);
+
+    // transparent image of size in logical pixels, paint gets a painter with the origin at its top left, shifted by phase,
+    // the image is large enough to cover the shifted size, unlike QPixmap this can be used outside of the gui thread
+    static QImage render(const QSize& size, qreal dpr, const std::function<void(QPainter*)>& paint);
+    static QImage render(const QSize& size, qreal dpr, const QPointF& phase, const std::function<void(QPainter*)>& paint);
+
+   private:
+    static int bucketId(qreal dpr);
+
+   private:
+    // there are more only with offscreen rendering at unusual scales, or with this many differently scaled screens
+    static constexpr size_t maxBuckets = 4;
+
+    const int maxSizeKiB;
+    std::map<int, QCache<Key, QPixmap>> buckets;  // by bucketId(), QCache can be neither copied nor moved so this is not a QHash
+};
+
+}  // namespace Lilac
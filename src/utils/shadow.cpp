@@ -0,0 +1,226 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#include <QPixmap>
+#include <QtMath>
+
+#include <cstring>
+#include <vector>
+
+#include "shadow.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define LILAC_SSE2 1
+#endif
+
+namespace Lilac {
+
+namespace {
+constexpr int maxBoxRadius = 128;  // the sums of a window have to fit into 16 bits
+
+// three passes of a box of width w have the variance 3 * (w * w - 1) / 12 of a gaussian
+int boxRadius(const qreal sigma) {
+    const qreal width = std::sqrt(4 * sigma * sigma + 1);
+    return qBound(0, qRound((width - 1) / 2), maxBoxRadius);
+}
+
+/*
+ * One box blur down the columns of src into dst, both tightly packed.
+ * The running sum of a window is kept per column, so neighbouring columns are independent and 8 of them are done at once with sse2,
+ * the division by the window is a multiplication by its 16 bit reciprocal, in the vector and in the scalar loop alike.
+ */
+void blurColumns(const uchar* src, uchar* dst, const int width, const int height, const int radius) {
+    const int window = 2 * radius + 1;
+    const quint32 reciprocal = (65536 + window - 1) / window;
+
+    int x = 0;
+#if LILAC_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i reciprocalV = _mm_set1_epi16(short(reciprocal));
+    const auto load = [&](const int y) {
+        return _mm_unpacklo_epi8(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + y * width + x)), zero);
+    };
+    for (; x + 8 <= width; x += 8) {
+        __m128i sum = zero;
+        for (int y = 0; y <= qMin(radius, height - 1); y++) {
+            sum = _mm_add_epi16(sum, load(y));
+        }
+        for (int y = 0; y < height; y++) {
+            _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + y * width + x), _mm_packus_epi16(_mm_mulhi_epu16(sum, reciprocalV), zero));
+            if (y + radius + 1 < height) {
+                sum = _mm_add_epi16(sum, load(y + radius + 1));
+            }
+            if (y - radius >= 0) {
+                sum = _mm_sub_epi16(sum, load(y - radius));
+            }
+        }
+    }
+#endif
+    for (; x < width; x++) {
+        quint32 sum = 0;
+        for (int y = 0; y <= qMin(radius, height - 1); y++) {
+            sum += src[y * width + x];
+        }
+        for (int y = 0; y < height; y++) {
+            dst[y * width + x] = uchar((sum * reciprocal) >> 16);
+            if (y + radius + 1 < height) {
+                sum += src[(y + radius + 1) * width + x];
+            }
+            if (y - radius >= 0) {
+                sum -= src[(y - radius) * width + x];
+            }
+        }
+    }
+}
+
+void transpose(const uchar* src, uchar* dst, const int width, const int height) {
+    for (int y = 0; y < height; y++) {
+        for (int x = 0; x < width; x++) {
+            dst[x * height + y] = src[y * width + x];
+        }
+    }
+}
+
+QImage shapeMask(const QSize& size, const QRectF& shape, const qreal radius) {
+    QImage mask(size, QImage::Format_Alpha8);
+    mask.fill(0);
+    QPainter painter(&mask);
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setPen(Qt::NoPen);
+    painter.setBrush(Qt::black);
+    painter.drawRoundedRect(shape, radius, radius);
+    return mask;
+}
+
+// all in device pixels, the shape is at (margin, margin), the returned image is transparent where the shape is
+QImage renderShadow(const QSize& shapeSize, const int margin, const qreal radius, const qreal sigma, const QPointF& offset, const QColor& color) {
+    const QSize size = shapeSize + QSize(2 * margin, 2 * margin);
+
+    QImage blurred = shapeMask(size, QRectF(QPointF(margin, margin) + offset, shapeSize), radius);
+    boxBlurAlpha(&blurred, sigma);
+    const QImage knockOut = shapeMask(size, QRectF(QPointF(margin, margin), shapeSize), radius);
+
+    QImage shadow(size, QImage::Format_ARGB32_Premultiplied);
+    const QRgb premultiplied = qPremultiply(color.rgba());
+    for (int y = 0; y < size.height(); y++) {
+        const uchar* blurredLine = blurred.constScanLine(y);
+        const uchar* knockOutLine = knockOut.constScanLine(y);
+        auto* line = reinterpret_cast<QRgb*>(shadow.scanLine(y));
+        for (int x = 0; x < size.width(); x++) {
+            const int alpha = blurredLine[x] * (255 - knockOutLine[x]) / 255;
+            line[x] = qRgba(qRed(premultiplied) * alpha / 255, qGreen(premultiplied) * alpha / 255, qBlue(premultiplied) * alpha / 255, qAlpha(premultiplied) * alpha / 255);
+        }
+    }
+    return shadow;
+}
+}  // namespace
+
+void boxBlurAlpha(QImage* image, const qreal sigma) {
+    Q_ASSERT(image->format() == QImage::Format_Alpha8);
+    const int radius = boxRadius(sigma);
+    const int width = image->width();
+    const int height = image->height();
+    if (radius <= 0 || width <= 0 || height <= 0) {
+        return;
+    }
+
+    std::vector<uchar> first(size_t(width) * height);
+    std::vector<uchar> second(first.size());
+    for (int y = 0; y < height; y++) {
+        std::memcpy(first.data() + size_t(y) * width, image->constScanLine(y), width);
+    }
+
+    // vertically, then the same for the transposed image, which is horizontally
+    for (int pass = 0; pass < 3; pass++) {
+        blurColumns(first.data(), second.data(), width, height, radius);
+        first.swap(second);
+    }
+    transpose(first.data(), second.data(), width, height);
+    first.swap(second);
+    for (int pass = 0; pass < 3; pass++) {
+        blurColumns(first.data(), second.data(), height, width, radius);
+        first.swap(second);
+    }
+    transpose(first.data(), second.data(), height, width);
+
+    for (int y = 0; y < height; y++) {
+        std::memcpy(image->scanLine(y), second.data() + size_t(y) * width, width);
+    }
+}
+
+RoundedRectShadow roundedRectShadow(const QSizeF& size, const qreal dpr, const qreal cornerRadius, const qreal blurRadius, const QPointF& offset, const QColor& color) {
+    RoundedRectShadow shadow;
+    shadow.dpr = dpr;
+    shadow.color = color;
+
+    // the shadow reaches about 2 sigma, the three boxes 3 sigma
+    shadow.radius = (size.isEmpty() ? cornerRadius : qMin(cornerRadius, qMin(size.width(), size.height()) / 2)) * dpr;
+    shadow.sigma = blurRadius * dpr / 2;
+    shadow.offset = offset * dpr;
+    const int reach = 3 * boxRadius(shadow.sigma) + qCeil(qMax(qAbs(shadow.offset.x()), qAbs(shadow.offset.y())));
+    shadow.margin = reach + 1;
+
+    // the sides of the smallest shape are straight in the middle, farther than reach from the corners
+    shadow.corner = qCeil(shadow.radius) + reach;
+    const QSize deviceSize = (size * dpr).toSize();
+    shadow.ninePatch = size.isEmpty() || (deviceSize.width() > 2 * shadow.corner + 1 && deviceSize.height() > 2 * shadow.corner + 1);
+    shadow.shapeSize = shadow.ninePatch ? QSize(2 * shadow.corner + 1, 2 * shadow.corner + 1) : deviceSize;
+
+    shadow.key = PixmapCache::key(PixmapCache::Shadow,
+                                  shadow.shapeSize.width(),
+                                  shadow.shapeSize.height(),
+                                  shadow.radius,
+                                  shadow.sigma,
+                                  shadow.offset.x(),
+                                  shadow.offset.y(),
+                                  color.rgba());
+    return shadow;
+}
+
+QImage RoundedRectShadow::render() const {
+    QImage image = renderShadow(shapeSize, margin, radius, sigma, offset, color);
+    image.setDevicePixelRatio(dpr);
+    return image;
+}
+
+void drawRoundedRectShadow(QPainter* p, PixmapCache* cache, const QRectF& rect, const qreal cornerRadius, const qreal blurRadius, const QPointF& offset, const QColor& color) {
+    if (rect.isEmpty() || blurRadius <= 0 || color.alpha() == 0) {
+        return;
+    }
+
+    const qreal dpr = p->device()->devicePixelRatioF();
+    const RoundedRectShadow shadow = roundedRectShadow(rect.size(), dpr, cornerRadius, blurRadius, offset, color);
+    QPixmap pixmap;
+    if (!cache->find(shadow.key, dpr, &pixmap)) {
+        pixmap = QPixmap::fromImage(shadow.render());
+        cache->insert(shadow.key, dpr, pixmap);
+    }
+
+    const int margin = shadow.margin;
+    const QRectF target = rect.adjusted(-margin / dpr, -margin / dpr, margin / dpr, margin / dpr);
+    if (!shadow.ninePatch) {
+        p->drawPixmap(target, pixmap, QRectF(pixmap.rect()));
+        return;
+    }
+
+    // source and target columns and rows: outer part with the corner, stretched middle, outer part with the other corner,
+    // the middle of the shape is transparent and left out
+    const int edge = margin + shadow.corner;
+    const qreal sourceX[4] = {0, qreal(edge), qreal(pixmap.width() - edge), qreal(pixmap.width())};
+    const qreal sourceY[4] = {0, qreal(edge), qreal(pixmap.height() - edge), qreal(pixmap.height())};
+    const qreal targetX[4] = {target.left(), target.left() + edge / dpr, target.right() - edge / dpr, target.right()};
+    const qreal targetY[4] = {target.top(), target.top() + edge / dpr, target.bottom() - edge / dpr, target.bottom()};
+    for (int row = 0; row < 3; row++) {
+        for (int column = 0; column < 3; column++) {
+            if (row == 1 && column == 1) {
+                continue;
+            }
+            p->drawPixmap(QRectF(QPointF(targetX[column], targetY[row]), QPointF(targetX[column + 1], targetY[row + 1])),
+                          pixmap,
+                          QRectF(QPointF(sourceX[column], sourceY[row]), QPointF(sourceX[column + 1], sourceY[row + 1])));
+        }
+    }
+}
+
+}  // namespace Lilac
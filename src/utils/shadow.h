@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#pragma once
+
+#include <QColor>
+#include <QImage>
+#include <QPainter>
+#include <QPointF>
+#include <QRectF>
+
+#include "pixmap_cache.h"
+
+namespace Lilac {
+
+// blurs a Format_Alpha8 image in place with three box blurs in each direction, which is close to a gaussian blur of sigma,
+// the pixels outside of the image count as transparent
+void boxBlurAlpha(QImage* image, const qreal sigma);
+
+// Draws the soft shadow of a rounded rect around it, the shadow is not drawn under the rect, so it can be translucent.
+// blurRadius is how far the shadow reaches, offset moves it relative to the rect.
+//
+// Only the shadow of the smallest rect which still has straight sides is rendered and cached in cache,
+// larger rects stretch those sides, so that the menus and popups of any size share it.
+void drawRoundedRectShadow(QPainter* p, PixmapCache* cache, const QRectF& rect, const qreal cornerRadius, const qreal blurRadius, const QPointF& offset, const QColor& color);
+
+// What drawRoundedRectShadow() caches for a rect of size, everything in device pixels except for size.
+// An empty size gives the nine patch that all rects large enough share, so it can be rendered ahead of time.
+struct RoundedRectShadow {
+    PixmapCache::Key key;
+    qreal dpr;
+    QSize shapeSize;
+    int margin;  // around the shape in the image
+    int corner;  // length of the parts of the shape with the corners, they are not stretched
+    bool ninePatch;
+    qreal radius;
+    qreal sigma;
+    QPointF offset;
+    QColor color;
+
+    QImage render() const;  // can be called outside of the gui thread
+};
+RoundedRectShadow roundedRectShadow(const QSizeF& size, const qreal dpr, const qreal cornerRadius, const qreal blurRadius, const QPointF& offset, const QColor& color);
+
+}  // namespace Lilac
@@ -0,0 +1,278 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#include <QImage>
+#include <QPaintDevice>
+#include <QPaintEngine>
+#include <QRegion>
+#include <QtMath>
+
+#include <algorithm>
+#include <cmath>
+
+#include "shape_rasterizer.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define LILAC_SSE2 1
+#endif
+
+namespace Lilac {
+
+namespace {
+// a rounded rect in device pixels, the radius is at most half of the shorter side
+struct Shape {
+    qreal centerX;
+    qreal centerY;
+    qreal halfWidth;
+    qreal halfHeight;
+    qreal radius;
+
+    Shape shrunk(const qreal by) const {
+        const qreal halfWidthShrunk = qMax<qreal>(halfWidth - by, 0);
+        const qreal halfHeightShrunk = qMax<qreal>(halfHeight - by, 0);
+        return {centerX, centerY, halfWidthShrunk, halfHeightShrunk, qBound<qreal>(0, radius - by, qMin(halfWidthShrunk, halfHeightShrunk))};
+    }
+
+    // signed distance of the point from the edge, negative inside
+    qreal distance(const qreal x, const qreal y) const {
+        const qreal qx = std::abs(x - centerX) - (halfWidth - radius);
+        const qreal qy = std::abs(y - centerY) - (halfHeight - radius);
+        const qreal outsideX = qMax<qreal>(qx, 0);
+        const qreal outsideY = qMax<qreal>(qy, 0);
+        return std::sqrt(outsideX * outsideX + outsideY * outsideY) + qMin<qreal>(qMax(qx, qy), 0) - radius;
+    }
+
+    // share of the pixel inside of the shape, 0 - 255, exact along the straight edges and close along the corners
+    int coverage(const int x, const int y) const {
+        return qRound(qBound<qreal>(0, 0.5 - distance(x + 0.5, y + 0.5), 1) * 255);
+    }
+};
+
+inline quint32 div255(const quint32 value) {
+    return (value + 128 + ((value + 128) >> 8)) >> 8;
+}
+
+// color is premultiplied
+inline quint32 blendPixel(const quint32 dst, const quint32 color) {
+    const quint32 inverseAlpha = 255 - (color >> 24);
+    quint32 result = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        result |= (((color >> shift) & 0xff) + div255(((dst >> shift) & 0xff) * inverseAlpha)) << shift;
+    }
+    return result;
+}
+
+inline quint32 scaleColor(const quint32 color, const int coverage) {
+    quint32 result = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        result |= div255(((color >> shift) & 0xff) * coverage) << shift;
+    }
+    return result;
+}
+
+// the fully covered middle of the rows, which is most of the shape
+void blendSpan(quint32* dst, const int count, const quint32 color) {
+    if ((color >> 24) == 255) {
+        std::fill(dst, dst + count, color);
+        return;
+    }
+
+    int i = 0;
+#if LILAC_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i inverseAlpha = _mm_set1_epi16(short(255 - (color >> 24)));
+    const __m128i half = _mm_set1_epi16(128);
+    const __m128i colorV = _mm_set1_epi32(int(color));
+    const auto scale = [&](const __m128i channels) {  // channels * inverseAlpha / 255, rounded like div255()
+        const __m128i product = _mm_add_epi16(_mm_mullo_epi16(channels, inverseAlpha), half);
+        return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+    };
+    for (; i + 4 <= count; i += 4) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+        const __m128i low = scale(_mm_unpacklo_epi8(pixels, zero));
+        const __m128i high = scale(_mm_unpackhi_epi8(pixels, zero));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_add_epi8(_mm_packus_epi16(low, high), colorV));
+    }
+#endif
+    for (; i < count; i++) {
+        dst[i] = blendPixel(dst[i], color);
+    }
+}
+
+// the image the painter ends up drawing into, and the part of it that may be changed, in device pixels
+struct Target {
+    QImage* image = nullptr;
+    QRegion clip;
+};
+
+// for a widget the raster engine draws into the backing store, its paint device is that image and not p->device(),
+// deviceTransform() then includes the position of the widget in the window, and the system clip is the exposed region
+bool rasterTarget(QPainter* p, Target* target) {
+    QPaintEngine* engine = p->paintEngine();
+    if (!engine || engine->type() != QPaintEngine::Raster || p->hasClipping() || p->compositionMode() != QPainter::CompositionMode_SourceOver) {
+        return false;
+    }
+    QPaintDevice* device = engine->paintDevice();
+    if (!device || device->devType() != QInternal::Image) {
+        return false;
+    }
+    auto* image = static_cast<QImage*>(device);
+    // an opaque backing store is RGB32, the blending keeps its alpha at 255
+    if (image->format() != QImage::Format_ARGB32_Premultiplied && image->format() != QImage::Format_RGB32) {
+        return false;
+    }
+    // the engine detaches the image when it begins, a copy made since then shares the pixels, which must not change under it
+    if (!image->isDetached()) {
+        return false;
+    }
+    const QTransform transform = p->deviceTransform();  // with the device pixel ratio
+    if (transform.type() > QTransform::TxScale || transform.m11() <= 0 || !qFuzzyCompare(transform.m11(), transform.m22())) {
+        return false;
+    }
+
+    target->image = image;
+    const QRegion systemClip = engine->systemClip();  // empty when painting on an image directly
+    target->clip = systemClip.isEmpty() ? QRegion(image->rect()) : systemClip.intersected(image->rect());
+    return true;
+}
+
+// The shapes are convex, so the fully covered pixels of a row are one span, with the edges on both of its sides.
+// Narrows [start, end) down to that span, calls edge for every pixel outside of it.
+template <typename Coverage, typename Edge>
+void findCoveredSpan(int* start, int* end, const Coverage& coverage, const Edge& edge) {
+    for (; *start < *end; (*start)++) {
+        const int value = coverage(*start);
+        if (value == 255) {
+            break;
+        }
+        edge(*start, value);
+    }
+    for (; *end > *start; (*end)--) {
+        const int value = coverage(*end - 1);
+        if (value == 255) {
+            break;
+        }
+        edge(*end - 1, value);
+    }
+}
+
+// the pixels of the shape within rect, which is inside of the image, color is premultiplied
+void rasterizeRect(QImage* image, const QRect& rect, const Shape& outer, const Shape* inner, const quint32 color) {
+    const auto blend = [color](quint32* line, const int x, const int coverage) {
+        if (coverage == 255) {
+            line[x] = blendPixel(line[x], color);
+        } else if (coverage > 0) {
+            line[x] = blendPixel(line[x], scaleColor(color, coverage));
+        }
+    };
+
+    for (int y = rect.top(); y < rect.top() + rect.height(); y++) {
+        // not scanLine(), that would detach the image from the one the paint engine draws into, rasterTarget() checks that no copy shares it
+        auto* line = reinterpret_cast<quint32*>(const_cast<uchar*>(image->constScanLine(y)));
+        // whether inner covers any pixel of the row, a pixel is covered if its center is closer than half a pixel
+        const bool innerRow = inner && y + 1 > inner->centerY - inner->halfHeight && y < inner->centerY + inner->halfHeight;
+
+        int spanStart = rect.left();
+        int spanEnd = rect.left() + rect.width();  // exclusive
+        findCoveredSpan(
+            &spanStart, &spanEnd, [&](const int x) { return outer.coverage(x, y); },
+            [&](const int x, const int coverage) { blend(line, x, innerRow ? coverage - inner->coverage(x, y) : coverage); });
+        if (!innerRow) {
+            blendSpan(line + spanStart, spanEnd - spanStart, color);
+            continue;
+        }
+
+        // outer covers the span fully, the part inner covers fully is the hole of the outline and is skipped
+        int holeStart = spanStart;
+        int holeEnd = spanEnd;
+        findCoveredSpan(
+            &holeStart, &holeEnd, [&](const int x) { return inner->coverage(x, y); },
+            [&](const int x, const int coverage) { blend(line, x, 255 - coverage); });
+    }
+}
+
+// inner is only used for outlines, the pixels inside of it are not covered
+void rasterize(QPainter* p, const Target& target, const Shape& outer, const Shape* inner, const QColor& color) {
+    QColor painted = color;
+    painted.setAlphaF(color.alphaF() * p->opacity());
+    const quint32 premultiplied = qPremultiply(painted.rgba());
+    if ((premultiplied >> 24) == 0) {
+        return;
+    }
+
+    const QRect bounds(QPoint(qFloor(outer.centerX - outer.halfWidth), qFloor(outer.centerY - outer.halfHeight)),
+                       QPoint(qCeil(outer.centerX + outer.halfWidth) - 1, qCeil(outer.centerY + outer.halfHeight) - 1));
+    for (const QRect& clipRect : target.clip.intersected(bounds)) {
+        rasterizeRect(target.image, clipRect, outer, inner, premultiplied);
+    }
+}
+
+Shape deviceShape(QPainter* p, const QRectF& rect, const qreal radius) {
+    const QRectF mapped = p->deviceTransform().mapRect(rect.normalized());
+    const qreal scale = p->deviceTransform().m11();
+    const qreal halfWidth = mapped.width() / 2;
+    const qreal halfHeight = mapped.height() / 2;
+    return {mapped.center().x(), mapped.center().y(), halfWidth, halfHeight, qBound<qreal>(0, radius * scale, qMin(halfWidth, halfHeight))};
+}
+}  // namespace
+
+void fillRoundedRect(QPainter* p, const QRectF& rect, const qreal radius, const QColor& color) {
+    Target target;
+    if (rasterTarget(p, &target)) {
+        rasterize(p, target, deviceShape(p, rect, radius), nullptr, color);
+        return;
+    }
+    p->save();
+    p->setRenderHints(QPainter::Antialiasing);
+    p->setPen(Qt::NoPen);
+    p->setBrush(color);
+    p->drawRoundedRect(rect, radius, radius);
+    p->restore();
+}
+
+void strokeRoundedRect(QPainter* p, const QRectF& rect, const qreal radius, const qreal width, const QColor& color) {
+    Target target;
+    if (rasterTarget(p, &target)) {
+        const Shape outer = deviceShape(p, rect, radius);
+        const Shape inner = outer.shrunk(width * p->deviceTransform().m11());
+        rasterize(p, target, outer, &inner, color);
+        return;
+    }
+    const qreal half = width / 2;
+    p->save();
+    p->setRenderHints(QPainter::Antialiasing);
+    p->setPen(QPen(color, width));
+    p->setBrush(Qt::NoBrush);
+    p->drawRoundedRect(rect.adjusted(half, half, -half, -half), qMax<qreal>(radius - half, 0), qMax<qreal>(radius - half, 0));
+    p->restore();
+}
+
+void fillEllipse(QPainter* p, const QRectF& rect, const QColor& color) {
+    if (qFuzzyCompare(rect.width(), rect.height())) {
+        fillRoundedRect(p, rect, rect.width() / 2, color);  // a circle
+        return;
+    }
+    p->save();
+    p->setRenderHints(QPainter::Antialiasing);
+    p->setPen(Qt::NoPen);
+    p->setBrush(color);
+    p->drawEllipse(rect);
+    p->restore();
+}
+
+void strokeEllipse(QPainter* p, const QRectF& rect, const qreal width, const QColor& color) {
+    if (qFuzzyCompare(rect.width(), rect.height())) {
+        strokeRoundedRect(p, rect, rect.width() / 2, width, color);
+        return;
+    }
+    const qreal half = width / 2;
+    p->save();
+    p->setRenderHints(QPainter::Antialiasing);
+    p->setPen(QPen(color, width));
+    p->setBrush(Qt::NoBrush);
+    p->drawEllipse(rect.adjusted(half, half, -half, -half));
+    p->restore();
+}
+
+}  // namespace Lilac
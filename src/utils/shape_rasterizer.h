@@ -0,0 +1,33 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#pragma once
+
+#include <QColor>
+#include <QPainter>
+#include <QRectF>
+
+namespace Lilac {
+
+// Antialiased rounded rects and circles, the shapes most elements are made of.
+// When the raster engine draws into a Format_ARGB32_Premultiplied or Format_RGB32 QImage, which is the backing store
+// for widgets or an image like the ones of PixmapCache::render(), without a clip set on the painter,
+// with CompositionMode_SourceOver and a transform which at most translates and scales uniformly,
+// the coverage of every pixel is computed from the distance to the edge and blended straight into the image,
+// within the system clip, which skips the path filling of QPainter. Otherwise they draw with the painter, the result looks the same.
+//
+// None of them change the state of the painter.
+
+// like p->drawRoundedRect(rect, radius, radius) with antialiasing, no pen and a solid brush of color
+void fillRoundedRect(QPainter* p, const QRectF& rect, const qreal radius, const QColor& color);
+
+// the outline of width inside of rect, like a pen of width drawing rect shrunk by width / 2, with the radius shrunk by as much
+void strokeRoundedRect(QPainter* p, const QRectF& rect, const qreal radius, const qreal width, const QColor& color);
+
+// like p->drawEllipse(rect) with antialiasing, no pen and a solid brush of color
+void fillEllipse(QPainter* p, const QRectF& rect, const QColor& color);
+
+// the outline of width inside of rect, like strokeRoundedRect()
+void strokeEllipse(QPainter* p, const QRectF& rect, const qreal width, const QColor& color);
+
+}  // namespace Lilac
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+// SPDX-FileCopyrightText: 2025 zalesyc and the lilac contributors
+
+#pragma once
+
+#include <QFlags>
+#include <QMetaObject>
+#include <QWidget>
+
+#include <cstring>
+
+namespace Lilac {
+
+// classes (including classes from other libraries and applications) that are drawn specially,
+// a widget may be more of these at once if they inherit each other
+enum class WidgetKind {
+    None = 0,
+    TreeView = 1 << 0,
+    ListView = 1 << 1,
+    KFilePlacesView = 1 << 2,
+    BreadCrumbView = 1 << 3,
+    DolphinTabBar = 1 << 4,
+    DolphinUrlNavigator = 1 << 5,
+    KUrlNavigatorButtonBase = 1 << 6,
+    Menu = 1 << 7,
+    ComboBox = 1 << 8,
+    AbstractSpinBox = 1 << 9,
+    KMultiTabBarTab = 1 << 10,
+};
+Q_DECLARE_FLAGS(WidgetKinds, WidgetKind)
+Q_DECLARE_OPERATORS_FOR_FLAGS(WidgetKinds)
+
+// walks the meta object hierarchy once, this is what QObject::inherits() does for every single class name
+inline WidgetKinds classifyWidget(const QWidget* widget) {
+    struct ClassKind {
+        const char* className;
+        WidgetKind kind;
+    };
+    static constexpr ClassKind classKinds[] = {
+        {"QTreeView", WidgetKind::TreeView},
+        {"QListView", WidgetKind::ListView},
+        {"KFilePlacesView", WidgetKind::KFilePlacesView},
+        {"BreadCrumbView", WidgetKind::BreadCrumbView},
+        {"DolphinTabBar", WidgetKind::DolphinTabBar},
+        {"DolphinUrlNavigator", WidgetKind::DolphinUrlNavigator},
+        {"KDEPrivate::KUrlNavigatorButtonBase", WidgetKind::KUrlNavigatorButtonBase},
+        {"QMenu", WidgetKind::Menu},
+        {"QComboBox", WidgetKind::ComboBox},
+        {"QAbstractSpinBox", WidgetKind::AbstractSpinBox},
+        {"KMultiTabBarTab", WidgetKind::KMultiTabBarTab},
+    };
+
+    WidgetKinds kinds;
+    if (!widget) {
+        return kinds;
+    }
+    for (const QMetaObject* metaObject = widget->metaObject(); metaObject; metaObject = metaObject->superClass()) {
+        const char* className = metaObject->className();
+        for (const ClassKind& classKind : classKinds) {
+            if (std::strcmp(className, classKind.className) == 0) {
+                kinds |= classKind.kind;
+            }
+        }
+    }
+    return kinds;
+}
+
+}  // namespace Lilac
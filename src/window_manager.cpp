@@ -72,6 +72,16 @@ class AppEventFilter : public QObject {
 
     //* event filter
     bool eventFilter(QObject* object, QEvent* event) override {
+        switch (event->type()) {
+            case QEvent::MouseButtonPress:
+            case QEvent::MouseMove:
+            case QEvent::MouseButtonRelease:
+                break;
+
+            default:
+                return false;
+        }
+
         if (event->type() == QEvent::MouseButtonRelease) {
             // stop drag timer
             if (_parent->_dragTimer.isActive()) {
@@ -122,12 +132,14 @@ class AppEventFilter : public QObject {
 };
 
 //_____________________________________________________________
-WindowManager::WindowManager()
-    : QObject() {
-    // install application wise event filter
+WindowManager::WindowManager(EventDispatcher* dispatcher)
+    : QObject(), _dispatcher(dispatcher) {
+    _dispatcher->setHandler(EventDispatcher::WindowDrag, this);
+
+    // application wise event filter, only installed while a drag is locked, pending or in progress
     _appEventFilter = new AppEventFilter(this);
-    qApp->installEventFilter(_appEventFilter);
     connect(&Config::get(), &Config::configChanged, this, &WindowManager::initialize);
+    initialize();
 }
 
 //_____________________________________________________________
@@ -140,19 +152,27 @@ void WindowManager::initialize() {
 
     initializeWhiteList();
     initializeBlackList();
+
+    // exceptions may have changed
+    _exceptionsCompiled = false;
+    _dragInfo.clear();
 }
 
 //_____________________________________________________________
 void WindowManager::registerWidget(QWidget* widget) {
-    if (isBlackListed(widget) || isDraggable(widget) || widget->inherits("QQuickWidget")) {
+    const DragInfo info = classify(widget);
+    if (info.blackListed || isDraggable(widget) || widget->inherits("QQuickWidget")) {
         /*
         install filter for draggable widgets.
         also install filter for blacklisted widgets
         to be able to catch the relevant events and prevent
         the drag to happen
         */
-        widget->removeEventFilter(this);
-        widget->installEventFilter(this);
+        _dispatcher->registerObject(widget, EventDispatcher::WindowDrag);
+
+        // keep the classification for mouse press
+        _dragInfo.insert(widget, info);
+        connect(widget, &QObject::destroyed, this, &WindowManager::widgetDestroyed, Qt::UniqueConnection);
     }
 }
 
@@ -166,8 +186,7 @@ void WindowManager::registerQuickItem(QQuickItem* item) {
     if (auto window = item->window()) {
         auto contentItem = window->contentItem();
         contentItem->setAcceptedMouseButtons(Qt::LeftButton);
-        contentItem->removeEventFilter(this);
-        contentItem->installEventFilter(this);
+        _dispatcher->registerObject(contentItem, EventDispatcher::WindowDrag);
     }
 }
 #endif
@@ -175,7 +194,8 @@ void WindowManager::registerQuickItem(QQuickItem* item) {
 //_____________________________________________________________
 void WindowManager::unregisterWidget(QWidget* widget) {
     if (widget) {
-        widget->removeEventFilter(this);
+        _dispatcher->unregisterObject(widget, EventDispatcher::WindowDrag);
+        _dragInfo.remove(widget);
     }
 }
 
@@ -185,7 +205,7 @@ void WindowManager::initializeWhiteList() {
                                             ExceptionId(QStringLiteral("ViewSliders@kmix")),
                                             ExceptionId(QStringLiteral("Sidebar_Widget@konqueror"))});
 
-    const auto windowDragWhiteList = QStringList();  // StyleConfigData::windowDragWhiteList();
+    const auto windowDragWhiteList = Config::get().windowDragWhiteList;
     for (const QString& exception : windowDragWhiteList) {
         ExceptionId id(exception);
         if (!id.className().isEmpty()) {
@@ -201,7 +221,7 @@ void WindowManager::initializeBlackList() {
          ExceptionId(QStringLiteral("MuseScore")),
          ExceptionId(QStringLiteral("KGameCanvasWidget"))});
 
-    const auto windowDragBlackList = QStringList();  //  StyleConfigData::windowDragBlackList();
+    const auto windowDragBlackList = Config::get().windowDragBlackList;
     for (const QString& exception : windowDragBlackList) {
         ExceptionId id(exception);
         if (!id.className().isEmpty()) {
@@ -210,8 +230,35 @@ void WindowManager::initializeBlackList() {
     }
 }
 
+//_____________________________________________________________
+void WindowManager::compileExceptions() {
+    const auto appName(qApp->applicationName());
+    if (_exceptionsCompiled && appName == _exceptionsAppName) {
+        return;
+    }
+
+    _whiteListMatcher.compile(_whiteList, appName);
+    _blackListMatcher.compile(_blackList, appName);
+    _exceptionsAppName = appName;
+    _exceptionsCompiled = true;
+
+    // the cached classifications were matched against the previous exceptions
+    _dragInfo.clear();
+
+    // if application name matches and all classes are selected
+    // disable the grabbing entirely
+    if (_blackListMatcher.matchesAll()) {
+        setEnabled(false);
+    }
+}
+
 //_____________________________________________________________
 bool WindowManager::eventFilter(QObject* object, QEvent* event) {
+    if (event->type() == QEvent::ParentChange) {
+        invalidateDragInfo(object);
+        return false;
+    }
+
     if (!enabled()) {
         return false;
     }
@@ -324,14 +371,15 @@ bool WindowManager::mousePressEvent(QObject* object, QEvent* event) {
     auto widget = static_cast<QWidget*>(object);
 
     // check if widget can be dragged from current position
-    if (isBlackListed(widget) || !canDrag(widget)) {
+    const DragInfo info = dragInfo(widget);
+    if (info.blackListed || !canDrag(widget)) {
         return false;
     }
 
     // retrieve widget's child at event position
     auto position(mouseEvent->pos());
     auto child = widget->childAt(position);
-    if (!canDrag(widget, child, position)) {
+    if (!canDrag(widget, info, child, position)) {
         return false;
     }
 
@@ -493,38 +541,14 @@ bool WindowManager::isBlackListed(QWidget* widget) {
     // }
 
     // list-based blacklisted widgets
-    const auto appName(qApp->applicationName());
-    for (const ExceptionId& id : std::as_const(_blackList)) {
-        if (!id.appName().isEmpty() && id.appName() != appName) {
-            continue;
-        }
-        if (id.className() == QStringLiteral("*") && !id.appName().isEmpty()) {
-            // if application name matches and all classes are selected
-            // disable the grabbing entirely
-            setEnabled(false);
-            return true;
-        }
-        if (widget->inherits(id.className().toLatin1().data())) {
-            return true;
-        }
-    }
-
-    return false;
+    compileExceptions();
+    return _blackListMatcher.matchesAll() || _blackListMatcher.matches(widget);
 }
 
 //_____________________________________________________________
-bool WindowManager::isWhiteListed(QWidget* widget) const {
-    const auto appName(qApp->applicationName());
-    for (const ExceptionId& id : std::as_const(_whiteList)) {
-        if (!(id.appName().isEmpty() || id.appName() == appName)) {
-            continue;
-        }
-        if (widget->inherits(id.className().toLatin1().data())) {
-            return true;
-        }
-    }
-
-    return false;
+bool WindowManager::isWhiteListed(QWidget* widget) {
+    compileExceptions();
+    return _whiteListMatcher.matches(widget);
 }
 
 //_____________________________________________________________
@@ -556,7 +580,81 @@ bool WindowManager::canDrag(QWidget* widget) {
 }
 
 //_____________________________________________________________
-bool WindowManager::canDrag(QWidget* widget, QWidget* child, const QPoint& position) {
+WindowManager::DragInfo WindowManager::dragInfo(QWidget* widget) {
+    const auto it = _dragInfo.constFind(widget);
+    if (it != _dragInfo.constEnd()) {
+        return *it;
+    }
+
+    const DragInfo info = classify(widget);
+    _dragInfo.insert(widget, info);
+    connect(widget, &QObject::destroyed, this, &WindowManager::widgetDestroyed, Qt::UniqueConnection);
+    return info;
+}
+
+//_____________________________________________________________
+WindowManager::DragInfo WindowManager::classify(QWidget* widget) {
+    DragInfo info;
+    info.blackListed = isBlackListed(widget);
+
+    if (qobject_cast<QToolButton*>(widget)) {
+        info.kind = DragInfo::ToolButton;
+    } else if (qobject_cast<QMenuBar*>(widget)) {
+        info.kind = DragInfo::MenuBar;
+    } else if (qobject_cast<QToolBar*>(widget)) {
+        info.kind = DragInfo::ToolBar;
+    } else if (qobject_cast<QTabBar*>(widget)) {
+        info.kind = DragInfo::TabBar;
+    } else if (qobject_cast<QGroupBox*>(widget)) {
+        info.kind = DragInfo::GroupBox;
+    } else if (qobject_cast<QLabel*>(widget)) {
+        info.kind = DragInfo::Label;
+    }
+
+    QWidget* parent = widget->parentWidget();
+    info.parentIsToolBar = qobject_cast<QToolBar*>(parent);
+
+    if (qobject_cast<QListView*>(parent) || qobject_cast<QTreeView*>(parent)) {
+        if (static_cast<QAbstractItemView*>(parent)->viewport() == widget) {
+            info.viewport = DragInfo::ListOrTreeViewport;
+        }
+    } else if (auto itemView = qobject_cast<QAbstractItemView*>(parent)) {
+        if (itemView->viewport() == widget) {
+            info.viewport = DragInfo::ItemViewViewport;
+        }
+    } else if (auto graphicsView = qobject_cast<QGraphicsView*>(parent)) {
+        if (graphicsView->viewport() == widget) {
+            info.viewport = DragInfo::GraphicsViewport;
+        }
+    }
+
+    return info;
+}
+
+//_____________________________________________________________
+void WindowManager::invalidateDragInfo(QObject* object) {
+    auto widget = qobject_cast<QWidget*>(object);
+    if (!widget) {
+        return;
+    }
+
+    // the classification of children depends on their parents too
+    for (auto it = _dragInfo.begin(); it != _dragInfo.end();) {
+        if (it.key() == widget || widget->isAncestorOf(static_cast<const QWidget*>(it.key()))) {
+            it = _dragInfo.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+//_____________________________________________________________
+void WindowManager::widgetDestroyed(QObject* object) {
+    _dragInfo.remove(object);
+}
+
+//_____________________________________________________________
+bool WindowManager::canDrag(QWidget* widget, const DragInfo& info, QWidget* child, const QPoint& position) {
     // retrieve child at given position and check cursor again
     if (child && child->cursor().shape() != Qt::ArrowCursor) {
         return false;
@@ -571,16 +669,20 @@ bool WindowManager::canDrag(QWidget* widget, QWidget* child, const QPoint& posit
     }
 
     // tool buttons
-    if (auto toolButton = qobject_cast<QToolButton*>(widget)) {
-        if (dragMode() == Config::WindowDragMode::ToolbarOnly && !qobject_cast<QToolBar*>(widget->parentWidget())) {
+    if (info.kind == DragInfo::ToolButton) {
+        auto toolButton = static_cast<QToolButton*>(widget);
+        if (dragMode() == Config::WindowDragMode::ToolbarOnly && !info.parentIsToolBar) {
             return false;
         }
         return toolButton->autoRaise() && !toolButton->isEnabled();
     }
 
     // check menubar
-    if (auto menuBar = qobject_cast<QMenuBar*>(widget)) {
+    if (info.kind == DragInfo::MenuBar) {
+        auto menuBar = static_cast<QMenuBar*>(widget);
+
         // do not drag from menubars embedded in Mdi windows
+        // not cached, reparenting an ancestor does not notify the menubar
         if (findParent<QMdiSubWindow*>(widget)) {
             return false;
         }
@@ -609,25 +711,23 @@ bool WindowManager::canDrag(QWidget* widget, QWidget* child, const QPoint& posit
     and does not come from a toolbar is rejected
     */
     if (dragMode() == Config::WindowDragMode::ToolbarOnly) {
-        if (qobject_cast<QToolBar*>(widget)) {
-            return true;
-        } else {
-            return false;
-        }
+        return info.kind == DragInfo::ToolBar;
     }
 
     /* following checks are relevant only for WD_FULL mode */
 
     // tabbar. Make sure no tab is under the cursor
-    if (auto tabBar = qobject_cast<QTabBar*>(widget)) {
-        return tabBar->tabAt(position) == -1;
+    if (info.kind == DragInfo::TabBar) {
+        return static_cast<QTabBar*>(widget)->tabAt(position) == -1;
     }
 
     /*
     check groupboxes
     prevent drag if unchecking grouboxes
     */
-    if (auto groupBox = qobject_cast<QGroupBox*>(widget)) {
+    if (info.kind == DragInfo::GroupBox) {
+        auto groupBox = static_cast<QGroupBox*>(widget);
+
         // non checkable group boxes are always ok
         if (!groupBox->isCheckable()) {
             return true;
@@ -664,17 +764,17 @@ bool WindowManager::canDrag(QWidget* widget, QWidget* child, const QPoint& posit
     }
 
     // labels
-    if (auto label = qobject_cast<QLabel*>(widget)) {
-        if (label->textInteractionFlags().testFlag(Qt::TextSelectableByMouse)) {
+    if (info.kind == DragInfo::Label) {
+        if (static_cast<QLabel*>(widget)->textInteractionFlags().testFlag(Qt::TextSelectableByMouse)) {
             return false;
         }
     }
 
     // abstract item views
-    QAbstractItemView* itemView(nullptr);
-    if ((itemView = qobject_cast<QListView*>(widget->parentWidget())) || (itemView = qobject_cast<QTreeView*>(widget->parentWidget()))) {
-        if (widget == itemView->viewport()) {
+    switch (info.viewport) {
+        case DragInfo::ListOrTreeViewport: {
             // QListView
+            auto itemView = static_cast<QAbstractItemView*>(widget->parentWidget());
             if (itemView->frameShape() != QFrame::NoFrame) {
                 return false;
             } else if (itemView->selectionMode() != QAbstractItemView::NoSelection && itemView->selectionMode() != QAbstractItemView::SingleSelection && itemView->model() && itemView->model()->rowCount()) {
@@ -682,21 +782,23 @@ bool WindowManager::canDrag(QWidget* widget, QWidget* child, const QPoint& posit
             } else if (itemView->model() && itemView->indexAt(position).isValid()) {
                 return false;
             }
+            break;
         }
 
-    } else if ((itemView = qobject_cast<QAbstractItemView*>(widget->parentWidget()))) {
-        if (widget == itemView->viewport()) {
+        case DragInfo::ItemViewViewport: {
             // QAbstractItemView
+            auto itemView = static_cast<QAbstractItemView*>(widget->parentWidget());
             if (itemView->frameShape() != QFrame::NoFrame) {
                 return false;
             } else if (itemView->indexAt(position).isValid()) {
                 return false;
             }
+            break;
         }
 
-    } else if (auto graphicsView = qobject_cast<QGraphicsView*>(widget->parentWidget())) {
-        if (widget == graphicsView->viewport()) {
+        case DragInfo::GraphicsViewport: {
             // QGraphicsView
+            auto graphicsView = static_cast<QGraphicsView*>(widget->parentWidget());
             if (graphicsView->frameShape() != QFrame::NoFrame) {
                 return false;
             } else if (graphicsView->dragMode() != QGraphicsView::NoDrag) {
@@ -704,7 +806,11 @@ bool WindowManager::canDrag(QWidget* widget, QWidget* child, const QPoint& posit
             } else if (graphicsView->itemAt(position)) {
                 return false;
             }
+            break;
         }
+
+        case DragInfo::NoViewport:
+            break;
     }
 
     return true;
@@ -723,6 +829,7 @@ void WindowManager::resetDrag() {
     _globalDragPoint = QPoint();
     _dragAboutToStart = false;
     _dragInProgress = false;
+    updateAppEventFilter();
 }
 
 //____________________________________________________________
@@ -749,6 +856,28 @@ void WindowManager::startDrag(QWindow* window) {
     {
         _dragInProgress = window->startSystemMove();
     }
+    updateAppEventFilter();
+}
+
+//____________________________________________________________
+void WindowManager::updateAppEventFilter() {
+    const bool needed = _locked || _dragInProgress || _dragTimer.isActive() || _target
+#if HAS_QTQUICK
+                        || _quickTarget
+#endif
+        ;
+
+    if (needed == _appEventFilterInstalled) {
+        return;
+    }
+
+    // removing the filter from within its own eventFilter() is fine, qApp skips removed filters
+    _appEventFilterInstalled = needed;
+    if (needed) {
+        qApp->installEventFilter(_appEventFilter);
+    } else {
+        qApp->removeEventFilter(_appEventFilter);
+    }
 }
 
 //____________________________________________________________
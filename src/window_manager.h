@@ -13,6 +13,7 @@ This file is originally from the Breeze style
 #include <QApplication>
 #include <QBasicTimer>
 #include <QEvent>
+#include <QHash>
 #include <QObject>
 #include <QPointer>
 #include <QSet>
@@ -24,6 +25,7 @@ This file is originally from the Breeze style
 #endif
 
 #include "config.h"
+#include "event_dispatcher.h"
 
 namespace Lilac {
 class AppEventFilter;
@@ -33,7 +35,8 @@ class WindowManager : public QObject {
 
    public:
     //* constructor
-    explicit WindowManager();
+    /** events of registered widgets are received through the dispatcher */
+    explicit WindowManager(EventDispatcher* dispatcher);
 
     //* initialize
     /** read relevant options from config */
@@ -123,14 +126,62 @@ class WindowManager : public QObject {
     bool isBlackListed(QWidget*);
 
     //* returns true if widget is draggable
-    bool isWhiteListed(QWidget*) const;
+    bool isWhiteListed(QWidget*);
+
+    //* compile white and black lists for the current application
+    /**
+    this is done lazily, because the application name may be set
+    only after the style has been created
+    */
+    void compileExceptions();
+
+    //* cached drag classification of a widget
+    /**
+    everything that only depends on the widget type, its position in the hierarchy
+    and the configured exceptions, so that mouse press does not have to walk parents
+    or match exceptions again
+    */
+    struct DragInfo {
+        //* type of the widget itself
+        enum Kind {
+            Other,
+            ToolButton,
+            MenuBar,
+            ToolBar,
+            TabBar,
+            GroupBox,
+            Label,
+        };
+
+        //* type of the view the widget is the viewport of
+        enum Viewport {
+            NoViewport,
+            ListOrTreeViewport,
+            ItemViewViewport,
+            GraphicsViewport,
+        };
+
+        Kind kind = Other;
+        Viewport viewport = NoViewport;
+        bool blackListed = false;
+        bool parentIsToolBar = false;
+    };
+
+    //* returns cached drag classification, computes it if needed
+    DragInfo dragInfo(QWidget*);
+
+    //* compute drag classification
+    DragInfo classify(QWidget*);
+
+    //* drop cached classification of widget and all its children
+    void invalidateDragInfo(QObject*);
 
     //* returns true if drag can be started from current widget
     bool canDrag(QWidget*);
 
     //* returns true if drag can be started from current widget and position
-    /** child at given position is passed as second argument */
-    bool canDrag(QWidget*, QWidget*, const QPoint&);
+    /** child at given position is passed as third argument */
+    bool canDrag(QWidget*, const DragInfo&, QWidget*, const QPoint&);
 
     //* reset drag
     void resetDrag();
@@ -138,6 +189,10 @@ class WindowManager : public QObject {
     //* start drag
     void startDrag(QWindow*);
 
+    //* install or remove the application event filter
+    /** it is only needed while the drag is locked, pending or in progress */
+    void updateAppEventFilter();
+
     //* utility function
     bool isDockWidgetTitle(const QWidget*) const;
 
@@ -146,6 +201,7 @@ class WindowManager : public QObject {
 
     void setLocked(bool value) {
         _locked = value;
+        updateAppEventFilter();
     }
 
     //* lock
@@ -159,6 +215,10 @@ class WindowManager : public QObject {
     template <typename T>
     T findParent(const QWidget*) const;
 
+   private Q_SLOTS:
+    //* remove destroyed widget from the cache
+    void widgetDestroyed(QObject*);
+
    private:
     //* enability
     bool _enabled = true;
@@ -174,6 +234,9 @@ class WindowManager : public QObject {
     /** this is copied from kwin::geometry */
     int _dragDelay = QApplication::startDragTime();
 
+    //* shared event filter, owned by the style
+    EventDispatcher* _dispatcher = nullptr;
+
     //* wrapper for exception id
     class ExceptionId {
        public:
@@ -212,6 +275,53 @@ class WindowManager : public QObject {
     //* exception set
     using ExceptionSet = QSet<ExceptionId>;
 
+    //* exceptions that apply to one application, hashed by class name
+    /**
+    matching a widget is then one lookup per class in its hierarchy,
+    instead of one inherits() call per exception
+    */
+    class ExceptionMatcher {
+       public:
+        //* keep only the exceptions relevant for appName
+        void compile(const ExceptionSet& exceptions, const QString& appName) {
+            _classNames.clear();
+            _matchesAll = false;
+            for (const ExceptionId& id : exceptions) {
+                if (!id.appName().isEmpty() && id.appName() != appName) {
+                    continue;
+                }
+                if (id.className() == QStringLiteral("*")) {
+                    // only valid together with an application name
+                    _matchesAll = _matchesAll || !id.appName().isEmpty();
+                    continue;
+                }
+                _classNames.insert(id.className().toLatin1());
+            }
+        }
+
+        //* true if the widget or one of its base classes is listed
+        bool matches(const QWidget* widget) const {
+            if (_classNames.isEmpty()) {
+                return false;
+            }
+            for (const QMetaObject* metaObject = widget->metaObject(); metaObject; metaObject = metaObject->superClass()) {
+                if (_classNames.contains(QByteArray::fromRawData(metaObject->className(), qstrlen(metaObject->className())))) {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        //* true if all classes are listed
+        bool matchesAll() const {
+            return _matchesAll;
+        }
+
+       private:
+        QSet<QByteArray> _classNames;
+        bool _matchesAll = false;
+    };
+
     //* list of white listed special widgets
     /**
     it is read from options and is used to adjust
@@ -226,6 +336,20 @@ class WindowManager : public QObject {
     */
     ExceptionSet _blackList;
 
+    //* compiled lists
+    ExceptionMatcher _whiteListMatcher;
+    ExceptionMatcher _blackListMatcher;
+
+    //* application name the lists were compiled for
+    QString _exceptionsAppName;
+
+    //* true if the compiled lists are up to date
+    bool _exceptionsCompiled = false;
+
+    //* cached drag classification
+    /** invalidated on reparent and when options are re-read */
+    QHash<const QObject*, DragInfo> _dragInfo;
+
     //* drag point
     QPoint _dragPoint;
     QPoint _globalDragPoint;
@@ -261,6 +385,9 @@ class WindowManager : public QObject {
     //* application event filter
     AppEventFilter* _appEventFilter = nullptr;
 
+    //* true if the application event filter is installed on qApp
+    bool _appEventFilterInstalled = false;
+
     //* allow access of all private members to the app event filter
     friend class AppEventFilter;
 };